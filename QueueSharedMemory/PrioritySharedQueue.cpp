@@ -0,0 +1,381 @@
+#include "PrioritySharedQueue.h"
+#include "SharedCopy.h"
+
+#include <atomic>
+#include <string.h>
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    const uint32_t PRIORITY_INFO_MAGIC   = 0x51534D50;  // 'QSMP'
+    const uint32_t PRIORITY_INFO_VERSION = 1;
+
+    const uint32_t RING_ALIGN            = 64;          // Ring    Cache line  .
+
+    // 0  ƴ mask    bit  ȣ return Ѵ.
+    uint32_t LowestBit(uint32_t mask)
+    {
+#ifdef _WIN32
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return (uint32_t)index;
+#else
+        return (uint32_t)__builtin_ctz(mask);
+#endif
+    }
+}
+
+// Shared Memory   տ ġ ϸ  ڿ RingInfo[priority_count], Ring    ʷ ٴ´.
+struct CPrioritySharedQueue::PriorityInfo
+{
+    //  ÿ ѹ  Ǵ 
+    alignas(64) std::atomic<uint32_t>   magic;
+    uint32_t                version;
+    uint32_t                priority_count;
+
+    // Message  ִ Ring  bit. Producer  Push Ŀ  Consumer    Ȯ Ŀ .
+    alignas(64) std::atomic<uint32_t>   ready_mask;
+
+    CSharedRing::Signal                 signal;
+};
+
+// 켱  ϳ Ring.   CSharedRing  а .
+struct CPrioritySharedQueue::RingInfo
+{
+    //  ÿ ѹ  Ǵ 
+    alignas(64) uint64_t    ring_offset;    // PriorityInfo    Ring     Byte ũ
+    uint64_t                ring_size;
+
+    // Producer   Cache line
+    alignas(64) std::atomic<uint64_t>   tail;
+
+    // Consumer   Cache line
+    alignas(64) std::atomic<uint64_t>   head;
+};
+
+CPrioritySharedQueue::CPrioritySharedQueue()
+    : m_priority_info(nullptr)
+    , m_rings(nullptr)
+    , m_base(nullptr)
+    , m_priority_count(0)
+    , m_error_code(0)
+{
+
+}
+
+CPrioritySharedQueue::~CPrioritySharedQueue()
+{
+    Finalize();
+}
+
+bool CPrioritySharedQueue::CreateSharedMemory(const std::vector<uint64_t>& ring_sizes)
+{
+    uint64_t size = CSharedRing::AlignUp(sizeof(PriorityInfo) + sizeof(RingInfo) * ring_sizes.size(), RING_ALIGN);
+    for (uint64_t ring_size : ring_sizes)
+        size += ring_size;
+
+    if (false == m_shared_memory.Create(m_name, size))
+    {
+        m_error_code = m_shared_memory.GetErrorCode();
+        return false;
+    }
+
+    //    0  ä Ƿ  Ring   ִ.
+    PriorityInfo* priority_info = reinterpret_cast<PriorityInfo*>(m_shared_memory.GetAddress());
+    RingInfo* rings = reinterpret_cast<RingInfo*>(priority_info + 1);
+    uint64_t ring_offset = CSharedRing::AlignUp(sizeof(PriorityInfo) + sizeof(RingInfo) * ring_sizes.size(), RING_ALIGN);
+    for (size_t i = 0; i < ring_sizes.size(); i++)
+    {
+        rings[i].ring_offset = ring_offset;
+        rings[i].ring_size = ring_sizes[i];
+        ring_offset += ring_sizes[i];
+    }
+
+    priority_info->priority_count = (uint32_t)ring_sizes.size();
+    priority_info->version = PRIORITY_INFO_VERSION;
+
+    priority_info->magic.store(PRIORITY_INFO_MAGIC, std::memory_order_release);
+
+    return true;
+}
+
+bool CPrioritySharedQueue::GetSharedPoint()
+{
+    if (m_shared_memory.GetSize() < sizeof(PriorityInfo))
+        return false;
+
+    PriorityInfo* priority_info = reinterpret_cast<PriorityInfo*>(m_shared_memory.GetAddress());
+    if (PRIORITY_INFO_MAGIC != priority_info->magic.load(std::memory_order_acquire) || PRIORITY_INFO_VERSION != priority_info->version ||
+        0 == priority_info->priority_count || priority_info->priority_count > MAX_PRIORITY_COUNT)
+        return false;
+
+    RingInfo* rings = reinterpret_cast<RingInfo*>(priority_info + 1);
+    for (uint32_t i = 0; i < priority_info->priority_count; i++)
+    {
+        if (m_shared_memory.GetSize() < rings[i].ring_offset + rings[i].ring_size)
+            return false;
+    }
+
+    m_priority_info = priority_info;
+    m_rings = rings;
+    m_base = reinterpret_cast<uint8_t*>(priority_info);
+    m_priority_count = priority_info->priority_count;
+
+    return true;
+}
+
+int CPrioritySharedQueue::Initialize(const std::string& name, const std::vector<uint64_t>& ring_sizes)
+{
+    Finalize();
+
+    if (ring_sizes.empty() || ring_sizes.size() > MAX_PRIORITY_COUNT)
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    std::vector<uint64_t> aligned_sizes;
+    for (uint64_t ring_size : ring_sizes)
+    {
+        if (ring_size < sizeof(MessageHeader))
+            return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+        aligned_sizes.push_back(CSharedRing::AlignUp(ring_size, RING_ALIGN));
+    }
+
+    m_name = name;
+
+    int ret = CSharedAttach::OpenOrCreate(m_shared_memory, m_name,
+        [&]() { return CreateSharedMemory(aligned_sizes); }, &m_error_code);
+    if (ret)
+    {
+        Finalize();
+        return ret;
+    }
+
+    bool matched = GetSharedPoint() && aligned_sizes.size() == m_priority_count;
+    for (uint32_t i = 0; matched && i < m_priority_count; i++)
+        matched = aligned_sizes[i] == m_rings[i].ring_size;
+
+    if (false == matched)
+    {
+        Finalize();
+        return CQueueSharedMemory::BRING_QUEUE_INFO;
+    }
+
+    if (false == m_data_event.Open(m_name + "_DataEvent", &m_priority_info->signal.data_event))
+    {
+        Finalize();
+        return CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE;
+    }
+
+    m_cached_heads.resize(m_priority_count);
+    m_cached_tails.resize(m_priority_count);
+    for (uint32_t i = 0; i < m_priority_count; i++)
+    {
+        m_cached_heads[i] = m_rings[i].head.load(std::memory_order_acquire);
+        m_cached_tails[i] = m_rings[i].tail.load(std::memory_order_acquire);
+    }
+
+    return 0;
+}
+
+void CPrioritySharedQueue::Finalize()
+{
+    m_data_event.Close();
+    m_shared_memory.Close();
+    m_priority_info = nullptr;
+    m_rings = nullptr;
+    m_base = nullptr;
+    m_priority_count = 0;
+    m_cached_heads.clear();
+    m_cached_tails.clear();
+    m_weights.clear();
+    m_credits.clear();
+}
+
+int CPrioritySharedQueue::PushMessage(uint32_t priority, const uint8_t* buffer, uint32_t buffer_len)
+{
+    if (nullptr == m_priority_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+    if (priority >= m_priority_count)
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    // tail  Producer   ϹǷ relaxed  д´.
+    RingInfo& ring = m_rings[priority];
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint64_t next_tail = 0;
+    MessageHeader* header = CSharedRing::Reserve(m_base + ring.ring_offset, ring.ring_size, tail, ring.head,
+                                                 &m_cached_heads[priority], buffer_len, &next_tail);
+    if (nullptr == header)
+        return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE;
+
+    header->length = buffer_len;
+    header->sequence = 0;
+    CSharedCopy::ToShared(header + 1, buffer, buffer_len);
+
+    ring.tail.store(next_tail, std::memory_order_release);
+
+    // tail   ready_mask  о Consumer  bit    ٽ Ȯ    Message  .
+    // ̹ bit  ִٸ RMW   ʴ´.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t bit = 1u << priority;
+    if (0 == (m_priority_info->ready_mask.load(std::memory_order_relaxed) & bit))
+        m_priority_info->ready_mask.fetch_or(bit, std::memory_order_release);
+
+    CSharedRing::Notify(m_priority_info->signal, m_data_event);
+
+    return 0;
+}
+
+// priority  *head ġ ִ Message  return Ѵ. ٸ nullptr  return Ѵ.
+CPrioritySharedQueue::MessageHeader* CPrioritySharedQueue::FrontMessage(uint32_t priority, uint64_t* head)
+{
+    RingInfo& ring = m_rings[priority];
+    return CSharedRing::Front(m_base + ring.ring_offset, ring.ring_size, ring.tail, &m_cached_tails[priority], head);
+}
+
+// ready_mask  bit   켱   Ȯ Ͽ   Ring  Message  .
+// ġ    Message  ִ Ring     ٸ  ٽ ä ѹ  .
+CPrioritySharedQueue::MessageHeader* CPrioritySharedQueue::SelectRing(uint32_t* priority, uint64_t* head)
+{
+    for (uint32_t round = 0; round < 2; round++)
+    {
+        uint32_t mask = m_priority_info->ready_mask.load(std::memory_order_acquire);
+        bool exhausted = false;
+        while (mask)
+        {
+            uint32_t index = LowestBit(mask);
+            mask &= mask - 1;
+
+            if (!m_weights.empty() && 0 == m_credits[index])
+            {
+                exhausted = true;
+                continue;
+            }
+
+            uint64_t pos_head = m_rings[index].head.load(std::memory_order_relaxed);
+            MessageHeader* header = FrontMessage(index, &pos_head);
+            if (nullptr == header)
+            {
+                // bit    ٽ Ȯ ؾ  ̿ Push Ǿ bit    Message  ġ ʴ´.
+                m_priority_info->ready_mask.fetch_and(~(1u << index), std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                header = FrontMessage(index, &pos_head);
+                if (nullptr == header)
+                    continue;
+
+                m_priority_info->ready_mask.fetch_or(1u << index, std::memory_order_relaxed);
+            }
+
+            *priority = index;
+            *head = pos_head;
+            return header;
+        }
+
+        if (false == exhausted)
+            break;
+
+        m_credits = m_weights;
+    }
+
+    return nullptr;
+}
+
+void CPrioritySharedQueue::PopFront(uint32_t priority, uint64_t head, uint32_t length)
+{
+    m_rings[priority].head.store(head + CSharedRing::RecordSize(length), std::memory_order_release);
+
+    if (!m_weights.empty())
+        m_credits[priority]--;
+}
+
+int CPrioritySharedQueue::PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t* priority)
+{
+    if (nullptr == m_priority_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    uint32_t index = 0;
+    uint64_t head = 0;
+    MessageHeader* header = SelectRing(&index, &head);
+    if (nullptr == header)
+        return CQueueSharedMemory::POP_DATA_EMPTY;
+
+    uint32_t length = header->length;
+    *message_len = length;
+    if (priority)
+        *priority = index;
+    if (buffer_len < length)
+        return CQueueSharedMemory::READ_BUFFER_SIZE_IS_SMALL;
+
+    CSharedCopy::FromShared(buffer, header + 1, length);
+    PopFront(index, head, length);
+
+    return 0;
+}
+
+int CPrioritySharedQueue::PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms, uint32_t* priority)
+{
+    if (nullptr == m_priority_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    return CSharedRing::PopWait(m_priority_info->signal, m_data_event, timeout_ms,
+        [&]() { return PopMessage(buffer, buffer_len, message_len, priority); });
+}
+
+int CPrioritySharedQueue::SetWeights(const std::vector<uint32_t>& weights)
+{
+    if (nullptr == m_priority_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    if (!weights.empty())
+    {
+        if (weights.size() != m_priority_count)
+            return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+        for (uint32_t weight : weights)
+        {
+            if (0 == weight)
+                return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+        }
+    }
+
+    m_weights = weights;
+    m_credits = weights;
+
+    return 0;
+}
+
+uint32_t CPrioritySharedQueue::GetReadyMask() const
+{
+    if (nullptr == m_priority_info)
+        return 0;
+
+    return m_priority_info->ready_mask.load(std::memory_order_acquire);
+}
+
+uint64_t CPrioritySharedQueue::GetUseSize(uint32_t priority) const
+{
+    if (nullptr == m_priority_info || priority >= m_priority_count)
+        return 0;
+
+    // head   о tail  Ŀ ʴ´.
+    uint64_t head = m_rings[priority].head.load(std::memory_order_acquire);
+    uint64_t tail = m_rings[priority].tail.load(std::memory_order_acquire);
+
+    return tail - head;
+}
+
+uint32_t CPrioritySharedQueue::GetPriorityCount() const
+{
+    return m_priority_count;
+}
+
+uint32_t CPrioritySharedQueue::GetWinErrorCode() const
+{
+    return m_error_code;
+}
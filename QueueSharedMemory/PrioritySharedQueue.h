@@ -0,0 +1,112 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    PrioritySharedQueue.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CPrioritySharedQueue
+///  @brief   ϳ Shared Memory ȿ 켱   ũⰡ ٸ SPSC Message Queue (Ring)   Ѵ.
+///           priority 0    Consumer       켱  Message   д´.
+///           SetWeights()  ġ ָ  켱  ġ ŭ   ʴ´.
+///           Ring     Ÿ bit   word (ready_mask)  ־
+///           Consumer   Ring  head / tail   ʰ word ϳ Ȯ Ѵ.
+///           Producer ϳ, Consumer ϳ     ִ.
+
+#include "QueueSharedMemory.h"
+#include "SharedAttach.h"
+#include "SharedEvent.h"
+#include "SharedMemory.h"
+#include "SharedRing.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CPrioritySharedQueue
+{
+private:
+    struct PriorityInfo;
+    struct RingInfo;
+    typedef CSharedRing::MessageHeader MessageHeader;
+
+    std::string    m_name;
+
+    CSharedMemory  m_shared_memory;
+    CSharedEvent   m_data_event;
+    PriorityInfo*  m_priority_info;
+    RingInfo*      m_rings;
+    uint8_t*       m_base;
+    uint32_t       m_priority_count;
+
+    // Producer  
+    std::vector<uint64_t>   m_cached_heads;
+
+    // Consumer  
+    std::vector<uint64_t>   m_cached_tails;
+    std::vector<uint32_t>   m_weights;      //    켱 
+    std::vector<uint32_t>   m_credits;      // ̹ round   Message 
+
+    uint32_t       m_error_code;
+
+private:
+    bool CreateSharedMemory(const std::vector<uint64_t>& ring_sizes);
+    bool GetSharedPoint();
+    MessageHeader* FrontMessage(uint32_t priority, uint64_t* head);
+    MessageHeader* SelectRing(uint32_t* priority, uint64_t* head);
+    void PopFront(uint32_t priority, uint64_t head, uint32_t length);
+
+public:
+    static const uint32_t MAX_PRIORITY_COUNT = 32;     // ready_mask  bit 
+
+    CPrioritySharedQueue();
+    ~CPrioritySharedQueue();
+
+    CPrioritySharedQueue(const CPrioritySharedQueue&) = delete;
+    CPrioritySharedQueue& operator=(const CPrioritySharedQueue&) = delete;
+
+    ///  @brief      ̸ Queue   ϰų ̹ ִ Queue   Ѵ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @param ring_sizes[in] : 켱   Ring    Byte ũ, [0]    켱  ̴.
+    ///                          ִ MAX_PRIORITY_COUNT  ̸  Cache line (64 Byte)   ø ȴ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    ///              ̹ ִ Queue  Ring  ٸٸ BRING_QUEUE_INFO  return Ѵ.
+    int Initialize(const std::string& name, const std::vector<uint64_t>& ring_sizes);
+
+    ///  @brief      Shared Memory    ü  Ѵ.
+    void Finalize();
+
+    ///  @brief      buffer  ϳ Message  priority  Ring  ߰ Ѵ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    int PushMessage(uint32_t priority, const uint8_t* buffer, uint32_t buffer_len);
+
+    ///  @brief        켱  (ġ  ÿ     켱 )  Message ϳ
+    ///              buffer  copy ϰ  Ѵ.
+    ///  @param message_len[out] : Message  Byte ũ. buffer  ۴ٸ ʿ ũⰡ  ȴ.
+    ///  @param priority[out] : nullptr  ƴ϶ Message  켱   ȴ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    int PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t* priority = nullptr);
+
+    ///  @brief      PopMessage()   Message  ٸ timeout_ms   Ѵ.
+    ///  @return      ð  TIMEOUT_EXPIRED  return Ѵ.
+    int PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms, uint32_t* priority = nullptr);
+
+    ///  @brief      켱   ġ  Ѵ.  round  priority p  ִ weights[p]  Message  
+    ///                ִ Ring       round   Ѵ.  ִ Ring   ٸ Ring   Ѵ.
+    ///  @param weights[in] : 켱   ŭ 1 ̻ .  ִٸ  켱  ǵ.
+    int SetWeights(const std::vector<uint32_t>& weights);
+
+    ///  @brief      Message  ִ 켱  bit (1 << priority)    return Ѵ.
+    ///              Consumer  Message     bit  Ƿ    ִ Ring  bit    ִ.
+    uint32_t GetReadyMask() const;
+
+    ///  @brief      priority  Ring   Byte ũ⸦ return Ѵ. (Message header )
+    uint64_t GetUseSize(uint32_t priority) const;
+
+    ///  @brief      켱   return Ѵ.
+    uint32_t GetPriorityCount() const;
+
+    ///  @brief      Windows  GetLastError(), Linux  errno  return Ѵ.
+    uint32_t GetWinErrorCode() const;
+};
@@ -0,0 +1,311 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    QueueCoroutine.h
+///  @date    2026/10/17
+///
+///  C++20 coroutine  CQueueSharedMemory   ϱ  awaitable   thread executor.
+///  C++20 coroutine   ϴ compiler   Ǹ ̺귯 ü C++17 ε  ȴ.
+///
+///  CQueueTask Consumer(CQueueExecutor& executor, CQueueSharedMemory& queue)
+///  {
+///      uint8_t buffer[256];
+///      uint32_t message_len = 0;
+///      while (0 == co_await PopAsync(executor, queue, buffer, sizeof(buffer), &message_len))
+///          ...
+///  }
+///
+///  executor.Spawn(Consumer(executor, queue));
+///  executor.Run();
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "QueueSharedMemory.h"
+#include "SharedEvent.h"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CQueueTask
+///  @brief   CQueueExecutor   Ǵ coroutine  return . Spawn()  ѱ executor   Ѵ.
+class CQueueTask
+{
+public:
+    struct promise_type
+    {
+        CQueueTask get_return_object()
+        {
+            return CQueueTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Spawn()  Run()   ϰ,  executor   Ѵ.
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit CQueueTask(std::coroutine_handle<promise_type> handle)
+        : m_handle(handle)
+    {
+
+    }
+
+    CQueueTask(CQueueTask&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+
+    }
+
+    ~CQueueTask()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    CQueueTask(const CQueueTask&) = delete;
+    CQueueTask& operator=(const CQueueTask&) = delete;
+    CQueueTask& operator=(CQueueTask&&) = delete;
+
+    std::coroutine_handle<promise_type> Release()
+    {
+        return std::exchange(m_handle, nullptr);
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CQueueExecutor
+///  @brief    Queue  ٸ  coroutine  ϳ thread   Ѵ.
+///            ٸ  coroutine   ʷ ٽ õ Ͽ  ϸ ̾  Ѵ.
+///           ѹ Ƶ  ٸ spin (pause) -> yield -> sleep (PARK_MAX_US  )  .
+///           Queue   μ  ϹǷ futex ϳ    sleep   Ѵ.
+class CQueueExecutor
+{
+private:
+    static const uint32_t IDLE_SPIN_COUNT  = 1024;
+    static const uint32_t IDLE_YIELD_COUNT = 64;
+    static const uint32_t PARK_MIN_US      = 50;
+    static const uint32_t PARK_MAX_US      = 1000;
+
+    struct Waiter
+    {
+        std::function<bool()>   try_func;   //   true
+        std::coroutine_handle<> handle;
+    };
+
+    std::vector<std::coroutine_handle<>> m_ready;
+    std::vector<Waiter>     m_waiters;
+    std::vector<Waiter>     m_polling;      // RunOnce()  Ȯ  Waiter
+    size_t                  m_task_count;
+
+private:
+    void Resume(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+
+        // Task ȿ ٸ Task  ٸ Ƿ  handle  Task ڽ ̴.
+        if (handle.done())
+        {
+            handle.destroy();
+            m_task_count--;
+        }
+    }
+
+public:
+    CQueueExecutor()
+        : m_task_count(0)
+    {
+
+    }
+
+    ~CQueueExecutor()
+    {
+        for (auto handle : m_ready)
+            handle.destroy();
+        for (auto& waiter : m_waiters)
+            waiter.handle.destroy();
+    }
+
+    CQueueExecutor(const CQueueExecutor&) = delete;
+    CQueueExecutor& operator=(const CQueueExecutor&) = delete;
+
+    ///  @brief      task   Ͽ ִ´. Run() / RunOnce()   ȴ.
+    void Spawn(CQueueTask task)
+    {
+        m_ready.push_back(task.Release());
+        m_task_count++;
+    }
+
+    ///  @brief      try_func  true  return    handle   д. awaitable   Ѵ.
+    void Park(std::coroutine_handle<> handle, std::function<bool()> try_func)
+    {
+        m_waiters.push_back(Waiter{ std::move(try_func), handle });
+    }
+
+    ///  @brief         ִ coroutine   ѹ  Ѵ.
+    ///  @return     ϳ  ߴٸ true  return Ѵ.
+    bool RunOnce()
+    {
+        bool progressed = false;
+
+        std::vector<std::coroutine_handle<>> ready;
+        ready.swap(m_ready);
+        for (auto handle : ready)
+        {
+            Resume(handle);
+            progressed = true;
+        }
+
+        // Resume() ߿ ٽ Park()   Ƿ  ٲ ΰ Ȯ Ѵ.
+        m_polling.clear();
+        m_polling.swap(m_waiters);
+        for (size_t i = 0; i < m_polling.size(); i++)
+        {
+            if (false == m_polling[i].try_func())
+            {
+                m_waiters.push_back(std::move(m_polling[i]));
+                continue;
+            }
+
+            Resume(m_polling[i].handle);
+            progressed = true;
+        }
+
+        return progressed;
+    }
+
+    ///  @brief       coroutine      Ѵ.
+    void Run()
+    {
+        uint32_t idle = 0;
+        uint32_t park_us = PARK_MIN_US;
+        while (m_task_count)
+        {
+            if (RunOnce())
+            {
+                idle = 0;
+                park_us = PARK_MIN_US;
+                continue;
+            }
+
+            idle++;
+            if (idle < IDLE_SPIN_COUNT)
+            {
+                CSharedEvent::CpuRelax();
+            }
+            else if (idle < IDLE_SPIN_COUNT + IDLE_YIELD_COUNT)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(park_us));
+                park_us = park_us * 2 < PARK_MAX_US ? park_us * 2 : PARK_MAX_US;
+            }
+        }
+    }
+
+    ///  @brief        coroutine   return Ѵ.
+    size_t GetTaskCount() const
+    {
+        return m_task_count;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// co_await PopAsync(...)  awaitable. Message  ٸ executor  ߰  ̾  ȴ.
+struct CQueuePopAwaiter
+{
+    CQueueExecutor&     executor;
+    CQueueSharedMemory& queue;
+    uint8_t*            buffer;
+    uint32_t            buffer_len;
+    uint32_t*           message_len;
+    int                 result;
+
+    bool TryPop()
+    {
+        result = queue.PopMessage(buffer, buffer_len, message_len);
+        return CQueueSharedMemory::POP_DATA_EMPTY != result;
+    }
+
+    bool await_ready()
+    {
+        return TryPop();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        executor.Park(handle, [this]() { return TryPop(); });
+    }
+
+    int await_resume() const
+    {
+        return result;
+    }
+};
+
+// co_await PushAsync(...)  awaitable.   ٸ executor  ߰  ̾  ȴ.
+struct CQueuePushAwaiter
+{
+    CQueueExecutor&     executor;
+    CQueueSharedMemory& queue;
+    const uint8_t*      buffer;
+    uint32_t            buffer_len;
+    int                 result;
+
+    bool TryPush()
+    {
+        result = queue.PushMessage(buffer, buffer_len);
+        return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != result;
+    }
+
+    // Queue   ִµ  ʴ ũ  ٸ ʴ´.
+    bool TryPushOrGiveUp()
+    {
+        return TryPush() || 0 == queue.GetUseSize();
+    }
+
+    bool await_ready()
+    {
+        return TryPushOrGiveUp();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        //  Ŀ Queue    ʴ´ٸ NOT_ENOUGH_FREE_SPACE  ̾  Ѵ.
+        executor.Park(handle, [this]() { return TryPushOrGiveUp(); });
+    }
+
+    int await_resume() const
+    {
+        return result;
+    }
+};
+
+///  @brief      PopMessage()  co_await   ְ Ѵ. Message  ٸ    coroutine  .
+///  @return     co_await   PopMessage()  return  ش.
+inline CQueuePopAwaiter PopAsync(CQueueExecutor& executor, CQueueSharedMemory& queue, uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
+{
+    return CQueuePopAwaiter{ executor, queue, buffer, buffer_len, message_len, 0 };
+}
+
+///  @brief      PushMessage()  co_await   ְ Ѵ.   ٸ    coroutine  .
+///  @return     co_await   PushMessage()  return  ش.
+inline CQueuePushAwaiter PushAsync(CQueueExecutor& executor, CQueueSharedMemory& queue, const uint8_t* buffer, uint32_t buffer_len)
+{
+    return CQueuePushAwaiter{ executor, queue, buffer, buffer_len, 0 };
+}
+
+#endif
@@ -1,8 +1,33 @@
 #include "QueueSharedMemory.h"
+#include "PrioritySharedQueue.h"
+#include "QueueCoroutine.h"
+#include "ShardedSharedQueue.h"
+#include "SharedAttach.h"
+#include "SharedCopy.h"
+#include "SharedEvent.h"
+#include "SharedMemory.h"
+#include "SharedRpcChannel.h"
+#include "SharedSlabPool.h"
+#include "TypedSharedQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
 
+#ifdef _WIN32
 #ifndef _WINDOWS_
 #include <windows.h>
 #endif
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -11,452 +36,3832 @@
 class CQueueSharedMemory::CQueueSharedMemoryImpl
 {
 private:
-#pragma pack(push, 1)
+    static const uint32_t QUEUE_INFO_MAGIC   = 0x51534D51;  // 'QSMQ'
+    static const uint32_t QUEUE_INFO_VERSION = 12;
+
+    // PopWait() / PushWait()     ٽ Ȯϴ Ƚ
+    static const uint32_t WAIT_SPIN_COUNT  = 1024;
+    static const uint32_t WAIT_YIELD_COUNT = 64;
+
+    enum QueueFlag
+    {
+        QUEUE_FLAG_MIRROR  = 0x01,      //   ι  mapping Ǿ 
+        QUEUE_FLAG_OVERRUN = 0x02,      // QUEUE_MODE_BROADCAST :  Consumer  ٸ ʰ  
+                                        // QUEUE_MODE_SPSC :   Message    (InitOption::overwrite_oldest)
+        QUEUE_FLAG_STATISTICS = 0x04,   // ConsumerCursor ڿ QueueStatistics  
+        QUEUE_FLAG_GROWABLE = 0x08,     //   overflow segment   Ѵ. (InitOption::max_segments)
+        QUEUE_FLAG_SNAPSHOT = 0x10,     // QueueStatistics ڿ SnapshotInfo  snapshot  
+    };
+
     // Shared Memory 󿡼  Ǵ Queue  
+    // head / tail   ϴ 64bit   ġ ( % queue_size) ̴.
+    // Producer  Consumer   ٸ Cache line   ġ Ѵ.
     struct QueueInfo
     {
-        uint32_t    tail;
-        uint32_t    head;
-        uint32_t    queue_size;
-        uint32_t    use_size;         //  Queue   Data Byte 
+        //  ÿ ѹ  Ǵ 
+        // magic  ٸ      release   Ǹ 0 ̸   ̴.
+        alignas(64) std::atomic<uint32_t> magic;
+        uint32_t                version;
+        uint32_t                flags;              // QueueFlag
+        uint32_t                mode;               // QueueMode
+        uint64_t                queue_size;
+        uint64_t                buffer_offset;      // QueueInfo     Byte ũ
+        uint64_t                slot_count;         // QUEUE_MODE_MPMC : Slot  
+        uint32_t                slot_size;          // QUEUE_MODE_MPMC : Slot ϳ Byte ũ (header )
+        uint32_t                consumer_count;     // QUEUE_MODE_BROADCAST : QueueInfo ٷ ڿ ִ ConsumerCursor  
+        uint32_t                max_segments;       // QUEUE_FLAG_GROWABLE : ѹ    ִ overflow segment  
+        uint32_t                snapshot_size;      // QUEUE_FLAG_SNAPSHOT : snapshot  Byte ũ
 
-        //  : m_user_space  ü  Ǿ ־ Ѵ.
         // Shared Memory   Ŀ  б/   ִ ̴.
-        uint8_t     m_user_space[32];
+        // user_space_sequence  Ȧ ̸  ִ ̴. (seqlock)
+        alignas(64) uint8_t     m_user_space[32];
+        std::atomic<uint32_t>   user_space_sequence;
+
+        // Producer   Cache line
+        alignas(64) std::atomic<uint64_t>   tail;
+        std::atomic<uint64_t>               claim;  // QUEUE_FLAG_OVERRUN :  ִ Message  .   - queue_size   .
+
+        // QUEUE_FLAG_GROWABLE :  ring   overflow segment  ȣ. 0 ̸ 
+        // overflow segment  SEGMENT_RETURN ̸ main ring  ư.
+        std::atomic<uint64_t>               next_segment;
+        uint64_t                            segment_count;      // main ring :   overflow segment  ȣ
+
+        // QUEUE_FLAG_OVERRUN  SPSC :      Message  ġ  Message  ȣ
+        std::atomic<uint64_t>               oldest;
+        uint64_t                            sequence;
+
+        // Consumer   Cache line
+        alignas(64) std::atomic<uint64_t>   head;
+        std::atomic<uint64_t>               consumer_segment;   // main ring : Consumer  а ִ overflow segment  ȣ. 0 ̸ main ring
+
+        // PopWait() / PushWait()   ִ    
+        // waiters  0  ƴ   event   Ű .
+        alignas(64) std::atomic<uint32_t>   data_event;
+        std::atomic<uint32_t>               data_waiters;
+        std::atomic<uint32_t>               space_event;
+        std::atomic<uint32_t>               space_waiters;
+
+        // ArmNotify()  Consumer  . ó Push  Producer  0  ٲٰ ˸ handle  ˸.
+        std::atomic<uint32_t>               notify_armed;
+    };
+
+    static_assert(sizeof(QueueInfo) % 64 == 0, "QueueInfo must be a multiple of the cache line size");
+
+    enum CursorState
+    {
+        CURSOR_FREE = 0,                //   
+        CURSOR_CLAIMING,                // Subscribe() . Producer    Ѵ.
+        CURSOR_ACTIVE,                  // Producer   ġ Ѿ   ʴ´.
+        CURSOR_LAGGED,                  // QUEUE_FLAG_OVERRUN :   Message   
+    };
+
+    // QUEUE_MODE_BROADCAST  Consumer  ϳ  б ġ. Consumer  Cache line   ʴ´.
+    struct alignas(64) ConsumerCursor
+    {
+        std::atomic<uint64_t>   position;   //   ġ. QueueInfo::head   ǹ
+        std::atomic<uint32_t>   state;      // CursorState
+    };
+
+    // InitOption::statistics   ϸ ConsumerCursor    ̿ д.
+    // Producer  Consumer   Cache line  ,  ϳ μ lock  load / store   Ų.
+    struct QueueStatistics
+    {
+        // Producer   Cache line
+        alignas(64) std::atomic<uint64_t>   push_count;
+        std::atomic<uint64_t>               push_bytes;
+        std::atomic<uint64_t>               push_full_count;
+        std::atomic<uint64_t>               push_wait_count;
+        std::atomic<uint64_t>               high_water_size;
+
+        // Consumer   Cache line
+        alignas(64) std::atomic<uint64_t>   pop_count;
+        std::atomic<uint64_t>               pop_bytes;
+        std::atomic<uint64_t>               pop_wait_count;
+    };
+
+    // InitOption::snapshot_size   ϸ QueueStatistics    ̿ θ ٷ ڿ snapshot  ִ.
+    // sequence  Ȧ ̸  ִ ̸ sequence / 2  version ̴. (seqlock)
+    struct SnapshotInfo
+    {
+        alignas(64) std::atomic<uint64_t>   sequence;
+        std::atomic<uint32_t>               length;
+    };
+
+    // overflow segment  next_segment   ̸ Producer  main ring  ư
+    static const uint64_t SEGMENT_RETURN = UINT64_MAX;
+
+    static const uint32_t MESSAGE_ALIGN       = 8;
+    static const uint32_t MESSAGE_WRAP_MARKER = 0xFFFFFFFF;
+
+    // PushMessage()   Ǵ Message տ ٴ header
+    // length  MESSAGE_WRAP_MARKER  Queue   ǳʶٰ 0   Message  ִ.
+    struct MessageHeader
+    {
+        uint32_t    length;
+        uint32_t    sequence;   // QUEUE_FLAG_OVERRUN  SPSC : Message ȣ  32bit. ǳʶ Message   .
+    };
+
+    static_assert(sizeof(MessageHeader) == MESSAGE_ALIGN, "MessageHeader must be MESSAGE_ALIGN bytes");
+
+    static uint64_t AlignMessage(uint64_t len)
+    {
+        return (len + (MESSAGE_ALIGN - 1)) & ~(uint64_t)(MESSAGE_ALIGN - 1);
+    }
+
+    // QUEUE_MODE_MPMC   ũ Slot տ ٴ header
+    // sequence  ġ    ְ, ġ + 1 ̸ Ͱ ִ. (Vyukov bounded MPMC queue)
+    struct SlotHeader
+    {
+        std::atomic<uint64_t>   sequence;
+        uint32_t                length;
+        uint32_t                reserved;
+    };
+
+    // QUEUE_FLAG_GROWABLE   overflow segment.  ũ SPSC Queue ̸ ̸ name.ȣ ̴.
+    struct OverflowSegment
+    {
+        uint64_t    index;
+        std::unique_ptr<CQueueSharedMemoryImpl> queue;
     };
-#pragma pack(pop)
 
     std::string    m_name;
 
-    HANDLE         m_memory_map;
+    CSharedMemory  m_shared_memory;
     QueueInfo*     m_queue_info;
     uint8_t*       m_queue_buffer;
+    bool           m_mirror;
+    QueueMode      m_mode;
+    uint32_t       m_slot_size;
+    uint64_t       m_slot_count;
+
+    // QUEUE_MODE_BROADCAST  Consumer  
+    ConsumerCursor* m_cursors;
+    uint32_t       m_consumer_count;
+    bool           m_overrun;
+    ConsumerCursor* m_cursor;           // Subscribe()   cursor
+
+    // QUEUE_FLAG_OVERRUN  SPSC (overwrite_oldest) 
+    bool           m_overwrite;
+    uint64_t       m_oldest;            // Producer :      Message  ġ
+    uint64_t       m_push_sequence;     // Producer :   Message  ȣ
+    uint32_t       m_pop_sequence;      // Consumer :     ϴ Message ȣ  32bit
+    bool           m_pop_sequence_valid;    // Consumer : ѹ ̻ о m_pop_sequence  ȿ 
+    uint64_t       m_lost_count;        // Consumer :     Message  
+
+    QueueStatistics* m_statistics;      //   ٸ nullptr
+    SnapshotInfo*  m_snapshot;          // snapshot  ٸ nullptr
+    uint8_t*       m_snapshot_buffer;
+    uint32_t       m_snapshot_size;
+
+    uint32_t       m_map_flags;         // InitOption::persistent, prefault, lock_memory  CSharedMemory::CreateFlag
+
+    // InitOption::persistent    
+    bool           m_persistent;
+    SyncPolicy     m_sync_policy;
+    uint64_t       m_sync_threshold;
+    uint64_t       m_sync_tail;         //     tail
+    uint64_t       m_sync_messages;     //    Message 
+    uint64_t       m_sync_bytes;        //    Byte ũ
+    bool           m_sync_pushed;       //   Ŀ Push . Pop  ߴٸ QueueInfo   Ѵ.
+    std::chrono::steady_clock::time_point m_sync_time;
+    bool           m_read_only;         // InitializeReadOnly()   
+
+    // QUEUE_FLAG_GROWABLE  overflow segment 
+    uint32_t       m_max_segments;      // 0 ̸ growable  ƴ
+    std::deque<OverflowSegment> m_write_segments;   // Producer : Consumer     segment,  .
+    uint64_t       m_chain_first;       // Producer : main ring  ù segment ȣ
+    OverflowSegment m_read_segment;     // Consumer : а ִ segment, main ring ̸ queue  nullptr
+    bool           m_waiting;           // PushWait() / PopWait()   . õ д 迡  ʴ´.
+
+    // Consumer  а  ϴ ġ. QUEUE_MODE_BROADCAST  ڽ cursor  Ų.
+    std::atomic<uint64_t>* m_head;
+
+    //  index  local 纻.   Shared Memory  ٽ д´.
+    uint64_t       m_cached_head;       // Producer  
+    uint64_t       m_cached_tail;       // Consumer  
+
+    // Reserve()  Commit()   tail, Peek()  Release()   head
+    // QUEUE_MODE_MPMC   Slot   ġ
+    MessageHeader* m_reserve_header;
+    uint64_t       m_reserve_tail;
+    MessageHeader* m_peek_header;
+    uint64_t       m_peek_head;
+    uint32_t       m_peek_len;
+    SlotHeader*    m_reserve_slot;
+    SlotHeader*    m_peek_slot;
+
+    CSharedEvent   m_data_event;        // Consumer  ͸ ٸ
+    CSharedEvent   m_space_event;       // Producer    ٸ
+
+    // OpenNotifyHandle()   ˸ handle
+#ifdef _WIN32
+    void*          m_notify_event;      // HANDLE, Producer  ó ˸  .
+#else
+    int            m_notify_fd;         // FIFO
+#endif
 
     uint32_t       m_pop_data_len;
     uint32_t       m_error_code;
 
 private:
-    bool CreateSharedMemory(int queue_size)
+    // head ġ Message header  return Ѵ. wrap marker  ǳʶٸ head  Message  ġ ش.
+    MessageHeader* FrontMessage(uint64_t* head)
     {
-        if (0 == queue_size)
-            return false;
-
-        m_memory_map = CreateFileMappingA(
-            INVALID_HANDLE_VALUE,               // hFile
-            NULL,                               // lpFileMappingAttributes
-            PAGE_READWRITE,                     // flProtect
-            0,                                  // dwMaximumSizeHigh
-            sizeof(QueueInfo) + queue_size,     // dwMaximumSizeLow
-            m_name.c_str());                    // lpName
+        uint64_t queue_size = m_queue_info->queue_size;
+        uint64_t pos_head = *head;
+        if (m_cached_tail == pos_head)
+        {
+            m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+            if (m_cached_tail == pos_head)
+                return nullptr;
+        }
 
-        if (NULL == m_memory_map)
+        uint64_t pos = pos_head % queue_size;
+        MessageHeader* header = reinterpret_cast<MessageHeader*>(&m_queue_buffer[pos]);
+        if (!m_mirror && MESSAGE_WRAP_MARKER == header->length)
         {
-            m_error_code = GetLastError();
-            return false;
+            // wrap marker   Message  Բ  ǹǷ ٽ Ȯ  ʿ䰡 .
+            pos_head += queue_size - pos;
+            header = reinterpret_cast<MessageHeader*>(&m_queue_buffer[0]);
         }
 
-        return true;
+        *head = pos_head;
+        return header;
     }
 
-    bool OpenSharedMemory()
+    // tail     ִ Consumer  ִٸ .
+    void NotifyData()
     {
-        m_memory_map = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, m_name.c_str());
-        if (!m_memory_map)
-        {
-            m_error_code = GetLastError();
-            return false;
-        }
+        // tail  data_waiters б  ؾ Consumer  鼭 ġ ʴ´.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t waiters = m_queue_info->data_waiters.load(std::memory_order_relaxed);
+        if (waiters)
+            m_data_event.Wake(waiters);
+
+        //  Cache line ̹Ƿ ArmNotify()  Consumer  ٸ ߰   .
+        if (m_queue_info->notify_armed.load(std::memory_order_relaxed) &&
+            m_queue_info->notify_armed.exchange(0, std::memory_order_acq_rel))
+            SignalNotify();
+    }
 
-        return true;
+    std::string GetSegmentName(uint64_t index) const
+    {
+        return m_name + "." + std::to_string(index);
     }
 
-    bool GetSharedPoint()
+    // QUEUE_FLAG_GROWABLE : main ring    overflow segment  .
+    // ѹ segment    ϸ Consumer   segment      main ring   ʾ   ȴ.
+    int PushGrowable(const uint8_t* buffer, uint32_t buffer_len)
     {
-        m_queue_info = (QueueInfo*)MapViewOfFile(m_memory_map, FILE_MAP_ALL_ACCESS, 0, 0, 0);
-        if (nullptr == m_queue_info)
+        if (m_write_segments.empty())
         {
-            m_error_code = GetLastError();
-            return false;
+            // ٸ Producer ü  segment   ִٸ   ̾ .
+            if (0 == m_queue_info->next_segment.load(std::memory_order_acquire))
+            {
+                int ret = PushRing(buffer, buffer_len);
+                if (NOT_ENOUGH_FREE_SPACE != ret)
+                    return ret;
+
+                // Queue   ־    ũ segment   ʴ´.
+                if (buffer_len > m_queue_info->queue_size || sizeof(MessageHeader) + AlignMessage(buffer_len) > m_queue_info->queue_size)
+                    return NOT_ENOUGH_FREE_SPACE;
+
+                return PushNewSegment(buffer, buffer_len);
+            }
+
+            int ret = AttachWriteSegments();
+            if (ret)
+                return ret;
         }
 
-        //  Queue ġ m_queue_info->m_user_space ġ  ִ.
-        m_queue_buffer = reinterpret_cast<uint8_t*>(&m_queue_info->m_user_space[0]) + sizeof(m_queue_info->m_user_space);
-        if (nullptr == m_queue_buffer)
-            return false;
+        // Consumer   segment  ݾƼ      ǵ Ѵ.
+        uint64_t consumer_segment = m_queue_info->consumer_segment.load(std::memory_order_acquire);
+        while (m_write_segments.size() > 1 && 0 != consumer_segment && m_write_segments.front().index < consumer_segment)
+            m_write_segments.pop_front();
 
-        return true;
-    }
+        // Consumer   segment   Դٸ main ring   Ƿ ư.
+        // main ring  link    Consumer  ƿ   segment   ʴ´.
+        if (consumer_segment == m_write_segments.back().index)
+        {
+            m_queue_info->next_segment.store(0, std::memory_order_relaxed);
+            m_write_segments.back().queue->m_queue_info->next_segment.store(SEGMENT_RETURN, std::memory_order_release);
+            m_write_segments.clear();
 
-public:
+            return PushRing(buffer, buffer_len);
+        }
 
-    CQueueSharedMemoryImpl()
-        : m_queue_buffer(nullptr)
-        , m_queue_info(nullptr)
-        , m_memory_map(NULL)
-        , m_pop_data_len(0)
-        , m_error_code(0)
-    {
+        int ret = m_write_segments.back().queue->PushRing(buffer, buffer_len);
+        if (NOT_ENOUGH_FREE_SPACE == ret)
+            return PushNewSegment(buffer, buffer_len);
+
+        // Consumer  main ring  event  ٸ.
+        if (0 == ret)
+            NotifyData();
 
+        return ret;
     }
 
-    virtual ~CQueueSharedMemoryImpl()
+    //  overflow segment   Message     ring   Ѵ.
+    int PushNewSegment(const uint8_t* buffer, uint32_t buffer_len)
     {
-        Finalize();
+        if (!m_write_segments.empty() && m_write_segments.back().index - m_chain_first + 1 >= m_max_segments)
+        {
+            RecordPushFull();
+            return NOT_ENOUGH_FREE_SPACE;
+        }
+
+        OverflowSegment segment{ m_queue_info->segment_count + 1, std::unique_ptr<CQueueSharedMemoryImpl>(new CQueueSharedMemoryImpl()) };
+        InitOption option;
+        option.mirror = m_mirror;
+        int ret = segment.queue->Initialize(GetSegmentName(segment.index), m_queue_info->queue_size, option);
+        if (ret)
+            return ret;
+
+        ret = segment.queue->PushRing(buffer, buffer_len);
+        if (ret)
+            return ret;
+
+        m_queue_info->segment_count = segment.index;
+        std::atomic<uint64_t>& link = m_write_segments.empty() ? m_queue_info->next_segment
+                                                               : m_write_segments.back().queue->m_queue_info->next_segment;
+        if (m_write_segments.empty())
+            m_chain_first = segment.index;
+
+        m_write_segments.push_back(std::move(segment));
+        link.store(m_write_segments.back().index, std::memory_order_release);
+        NotifyData();
+
+        return 0;
     }
 
-    int Initialize(const std::string& name, uint32_t queue_size)
+    //  Producer ü  segment  Consumer  ġ    .
+    int AttachWriteSegments()
     {
-        m_name = name;
+        m_chain_first = m_queue_info->next_segment.load(std::memory_order_acquire);
+        uint64_t index = m_queue_info->consumer_segment.load(std::memory_order_acquire);
+        if (0 == index)
+            index = m_chain_first;
 
-        bool create = false;
-        if (false == OpenSharedMemory())
+        while (0 != index && SEGMENT_RETURN != index)
         {
-            if (false == CreateSharedMemory(queue_size))
-                return CREATE_MAMORY_MAP_HANDLE;
+            OverflowSegment segment{ index, std::unique_ptr<CQueueSharedMemoryImpl>(new CQueueSharedMemoryImpl()) };
+            int ret = segment.queue->Initialize(GetSegmentName(index), 0, InitOption());
+            if (ret)
+            {
+                m_write_segments.clear();
+                return ret;
+            }
 
-            create = true;
+            index = segment.queue->m_queue_info->next_segment.load(std::memory_order_acquire);
+            m_write_segments.push_back(std::move(segment));
         }
 
-        if (false == GetSharedPoint())
+        if (m_write_segments.empty())
             return BRING_QUEUE_INFO;
 
-        if (create)
-            m_queue_info->queue_size = queue_size;
-
         return 0;
     }
 
-    void Finalize()
+    // QUEUE_FLAG_GROWABLE : а ִ ring    segment   Ǿ ִٸ  .
+    int PopGrowable(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
     {
-        if (m_queue_info)
+        // ٸ Consumer ü д segment  ִٸ    д´.
+        if (nullptr == m_read_segment.queue)
         {
-            UnmapViewOfFile(m_queue_info);
-            m_queue_info = nullptr;
-            m_queue_buffer = nullptr;
+            uint64_t consumer_segment = m_queue_info->consumer_segment.load(std::memory_order_relaxed);
+            if (consumer_segment)
+            {
+                int ret = SwitchReadSegment(consumer_segment);
+                if (ret)
+                    return ret;
+            }
         }
 
-        if (m_memory_map)
+        while (true)
         {
-            CloseHandle(m_memory_map);
-            m_memory_map = NULL;
-        }
-    }
+            CQueueSharedMemoryImpl* queue = m_read_segment.queue ? m_read_segment.queue.get() : this;
+            int ret = queue->PopRing(buffer, buffer_len, message_len);
+            if (POP_DATA_EMPTY != ret)
+            {
+                // Producer  main ring  event  ٸ.
+                if (0 == ret && queue != this)
+                    NotifySpace();
 
-    std::string GetName() const
-    {
-        if (!m_queue_info)
-            return std::string();
+                return ret;
+            }
 
-        return m_name;
-    }
+            // link   Message   Ŀ  ǹǷ link    ѹ  Ȯ ؾ Ѵ.
+            uint64_t next = queue->m_queue_info->next_segment.load(std::memory_order_acquire);
+            if (0 == next)
+                return POP_DATA_EMPTY;
 
-    int GetInformation(uint8_t* buffer)
-    {
-        if (!m_queue_info)
-            return DID_NOT_INITIALIZE;
+            ret = queue->PopRing(buffer, buffer_len, message_len);
+            if (POP_DATA_EMPTY != ret)
+            {
+                if (0 == ret && queue != this)
+                    NotifySpace();
 
-        memcpy(buffer, &m_queue_info->m_user_space[0], sizeof(m_queue_info->m_user_space));
+                return ret;
+            }
 
-        return 0;
+            ret = SwitchReadSegment(next);
+            if (ret)
+                return ret;
+        }
     }
 
-    int SetInformation(uint8_t* buffer)
+    int SwitchReadSegment(uint64_t index)
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
+        if (SEGMENT_RETURN == index)
+        {
+            m_read_segment.queue.reset();
+            m_read_segment.index = 0;
+            m_queue_info->consumer_segment.store(0, std::memory_order_release);
+            return 0;
+        }
 
-        memcpy(&m_queue_info->m_user_space[0], buffer, sizeof(m_queue_info->m_user_space));
+        std::unique_ptr<CQueueSharedMemoryImpl> queue(new CQueueSharedMemoryImpl());
+        int ret = queue->Initialize(GetSegmentName(index), 0, InitOption());
+        if (ret)
+            return ret;
+
+        //  segment  ⼭  Producer  ݾҴٸ  ȴ.
+        m_read_segment.queue = std::move(queue);
+        m_read_segment.index = index;
+        m_queue_info->consumer_segment.store(index, std::memory_order_release);
 
         return 0;
     }
 
-    int Clear()
+    // ˸ handle  ̸. Linux  /dev/shm Ʒ FIFO  ̴.
+    std::string GetNotifyName() const
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
+#ifdef _WIN32
+        return GetEventName("_NotifyEvent");
+#else
+        std::string name = m_name;
+        for (char& c : name)
+        {
+            if ('/' == c)
+                c = '_';
+        }
 
-        ZeroMemory(m_queue_buffer, sizeof(uint8_t) * GetQueueSize());
-        m_queue_info->head = 0;
-        m_queue_info->tail = 0;
-        m_queue_info->use_size = 0;
+        return "/dev/shm/" + name + ".notify";
+#endif
+    }
 
-        return 0;
+    // ˸ handle    ִ (signal ) · .
+    void SignalNotify()
+    {
+#ifdef _WIN32
+        if (nullptr == m_notify_event)
+            m_notify_event = CreateEventA(nullptr, FALSE, FALSE, GetNotifyName().c_str());
+        if (m_notify_event)
+            SetEvent((HANDLE)m_notify_event);
+#else
+        // б /   Consumer   Ŀ ENXIO / SIGPIPE    ִ.
+        // ˸ ArmNotify()  ѹ  ̹Ƿ fd    ʴ´.
+        int fd = open(GetNotifyName().c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        // pipe   áٸ ̹   ִ  ̹Ƿ д  Ѵ.
+        uint8_t value = 1;
+        if (write(fd, &value, sizeof(value)) < 0)
+            m_error_code = errno;
+        close(fd);
+#endif
     }
 
-    int Push(uint8_t* buffer, uint32_t buffer_len)
+    void CloseNotify()
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
+#ifdef _WIN32
+        if (m_notify_event)
+            CloseHandle((HANDLE)m_notify_event);
+        m_notify_event = nullptr;
+#else
+        if (m_notify_fd >= 0)
+            close(m_notify_fd);
+        m_notify_fd = -1;
+#endif
+    }
 
-        if (buffer_len > GetFreeSize())
-            return NOT_ENOUGH_FREE_SPACE;
+    // head     ִ Producer  ִٸ .
+    void NotifySpace()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t waiters = m_queue_info->space_waiters.load(std::memory_order_relaxed);
+        if (waiters)
+            m_space_event.Wake(waiters);
+    }
 
-        // --- :    *** :  
-        //   0                                      queue_size
-        //   |--------------H************T--------------|
-        //                               |----------| <=== write_size
-        uint32_t write_size = GetQueueSize() - m_queue_info->tail;
-        if (write_size < buffer_len)
-        {
-            //   0                                      queue_size
-            //   |--------------H************T--------------|
-            //                               |--------------| <=== write_size Push
-            // Tail ڿ buffer  write_size ũ ŭ  Ѵ.
-            memcpy(&m_queue_buffer[m_queue_info->tail], buffer, write_size);
+    // Producer    ȵǴ   ġ д´.
+    // QUEUE_MODE_BROADCAST    Consumer  ġ̸, ڰ ٸ tail ̴.
+    // QUEUE_FLAG_OVERRUN ̸ limit  µ ذ Ǵ Consumer  CURSOR_LAGGED  ǥ ϰ ٸ ʴ´.
+    uint64_t LoadConsumerHead(uint64_t tail, uint64_t limit)
+    {
+        if (QUEUE_MODE_BROADCAST != m_mode)
+            return m_queue_info->head.load(std::memory_order_acquire);
 
-            //   0                                      queue_size
-            //   |--------------H************T--------------|
-            //   |-----------| <=== (buffer_len - write_size) Push
-            //  ͸  Ѵ.
-            memcpy(&m_queue_buffer[0], &buffer[write_size], buffer_len - write_size);
-            m_queue_info->tail = buffer_len - write_size;
-        }
-        else
+        uint64_t head = tail;
+        uint64_t queue_size = m_queue_info->queue_size;
+        for (uint32_t i = 0; i < m_consumer_count; i++)
         {
-            //   0                                      queue_size
-            //   |--------------H************T--------------|
-            //                               |----------|  <== buffer_len Push
-            memcpy(&m_queue_buffer[m_queue_info->tail], buffer, buffer_len);
-            m_queue_info->tail += buffer_len;
-        }
+            ConsumerCursor& cursor = m_cursors[i];
+            if (CURSOR_ACTIVE != cursor.state.load(std::memory_order_acquire))
+                continue;
+
+            uint64_t position = cursor.position.load(std::memory_order_acquire);
+            if (m_overrun && position + queue_size < limit)
+            {
+                uint32_t state = CURSOR_ACTIVE;
+                cursor.state.compare_exchange_strong(state, CURSOR_LAGGED);
+                continue;
+            }
 
-        m_queue_info->use_size += buffer_len;
+            if (position < head)
+                head = position;
+        }
 
-        return 0;
+        return head;
     }
 
-    int Front(uint8_t* buffer, uint32_t buffer_len)
+    //  tail  е ڽ cursor  ű Producer  ̰ Ѵ.
+    void ActivateCursor()
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
+        m_cursor->position.store(m_queue_info->tail.load(std::memory_order_acquire), std::memory_order_relaxed);
+        m_cursor->state.store(CURSOR_ACTIVE, std::memory_order_seq_cst);
+
+        // ACTIVE  ̱  Producer      Ƿ tail  ٽ д´.
+        //   Producer   cursor     ʴ´.
+        m_cached_tail = m_queue_info->tail.load(std::memory_order_seq_cst);
+        m_cursor->position.store(m_cached_tail, std::memory_order_release);
+        m_peek_header = nullptr;
+    }
 
-        if (m_queue_info->use_size < buffer_len)
-            return READ_BUFFER_SIZE_IS_BIG;
+    // QUEUE_MODE_BROADCAST   ο  Ȯ Ѵ. ٸ ֽ ġ ű.
+    int CheckCursor()
+    {
+        if (QUEUE_MODE_BROADCAST != m_mode)
+            return 0;
+        if (nullptr == m_cursor)
+            return DID_NOT_SUBSCRIBE;
 
-        // --- :    *** :  
-        //   0                                      queue_size
-        //   |**************T------------H**************|
-        //                               |----------| <=== read_size
-        uint32_t read_size = GetQueueSize() - m_queue_info->head;
-        if (read_size < buffer_len)
-        {
-            //   0                                      queue_size
-            //   |**************T------------H**************|
-            //                               |--------------| <=== read_size Pop
-            memcpy(buffer, &m_queue_buffer[m_queue_info->head], read_size);
-            //   0                                      queue_size
-            //   |**************T------------H**************|
-            //   |--------| <=== (buffer_len - read_size) Pop
-            memcpy(&buffer[read_size], &m_queue_buffer[0], buffer_len - read_size);
-        }
-        else
+        if (CURSOR_LAGGED == m_cursor->state.load(std::memory_order_acquire))
         {
-            //   0                                      queue_size
-            //   |--------------H************T--------------|
-            //                  |----------| <=== buffer_len Pop
-            memcpy(buffer, &m_queue_buffer[m_queue_info->head], buffer_len);
+            ActivateCursor();
+            return CONSUMER_LAGGED;
         }
 
-        m_pop_data_len = buffer_len;
-
         return 0;
     }
 
-    int Pop()
+    // QUEUE_FLAG_OVERRUN  ڽ ġ     ̿   Ȯ Ѵ. (seqlock   )
+    int CheckOverwritten()
     {
-        if (0 == m_pop_data_len)
-            return POP_DATA_EMPTY;
-
-        uint32_t nReadSize = GetQueueSize() - m_queue_info->head;
-        if (nReadSize < m_pop_data_len)
-            m_queue_info->head = m_pop_data_len - nReadSize;
-        else
-            m_queue_info->head = m_queue_info->head + m_pop_data_len;
+        if (!m_overrun)
+            return 0;
 
-        m_queue_info->use_size -= m_pop_data_len;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t claim = m_queue_info->claim.load(std::memory_order_relaxed);
+        if (claim <= m_head->load(std::memory_order_relaxed) + m_queue_info->queue_size)
+            return 0;
 
-        m_pop_data_len = 0;
+        if (m_overwrite)
+            ResyncOldest();
+        else
+            ActivateCursor();
 
-        return 0;
+        return CONSUMER_LAGGED;
     }
 
-    int SetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len)
+    // QUEUE_FLAG_OVERRUN  SPSC       Message  ٽ е head  ű.
+    // Producer  oldest  claim    ϹǷ  claim ŭ ռ ִ.
+    void ResyncOldest()
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
-        if (pos < 0 || pos + buffer_len >= GetQueueSize())
-            return RANGE_IS_NOT_RIGHT;
-
-        memcpy(&m_queue_buffer[pos], buffer, buffer_len);
-
-        return 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t oldest = m_queue_info->oldest.load(std::memory_order_relaxed);
+        if (oldest > m_head->load(std::memory_order_relaxed))
+            m_head->store(oldest, std::memory_order_release);
+
+        //  ϴ tail  ű head  ڿ   Ƿ ٽ д´. ׷  FrontMessage()     Ѵ.
+        m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+        m_peek_header = nullptr;
     }
 
-    int GetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len)
+    // QUEUE_FLAG_OVERRUN  SPSC   Message  ȣ  տ ǳʶ Message   .
+    void CountLost(uint32_t sequence)
     {
-        if (nullptr == m_queue_info)
-            return DID_NOT_INITIALIZE;
-        if (pos < 0 || pos >= GetQueueSize())
-            return RANGE_IS_NOT_RIGHT;
-        if (GetQueueSize() - pos < buffer_len)
-            return RANGE_IS_NOT_RIGHT;
+        if (!m_overwrite)
+            return;
 
-        memcpy(buffer, &m_queue_buffer[pos], buffer_len);
+        if (m_pop_sequence_valid)
+            m_lost_count += (uint32_t)(sequence - m_pop_sequence);
 
-        return 0;
+        m_pop_sequence = sequence;
+        m_pop_sequence_valid = true;
     }
 
-    uint32_t GetUseSize() const
+    // Producer  limit    ֵ   Message  . ڽ  header  Ƿ Consumer   .
+    void DropOldest(uint64_t limit)
     {
-        if (!m_queue_info)
-            return 0;
+        uint64_t queue_size = m_queue_info->queue_size;
+        while (limit - m_oldest > queue_size)
+        {
+            uint64_t pos = m_oldest % queue_size;
+            const MessageHeader* header = reinterpret_cast<const MessageHeader*>(&m_queue_buffer[pos]);
+            if (!m_mirror && MESSAGE_WRAP_MARKER == header->length)
+                m_oldest += queue_size - pos;
+            else
+                m_oldest += sizeof(MessageHeader) + AlignMessage(header->length);
+        }
 
-        return m_queue_info->use_size;
+        m_queue_info->oldest.store(m_oldest, std::memory_order_relaxed);
     }
 
-    uint32_t GetQueueSize() const
+    //  μ  counter  load / store ,  μ  counter  fetch_add   Ų.
+    static void AddCounter(std::atomic<uint64_t>& counter, uint64_t value, bool shared)
     {
-        if (!m_queue_info)
-            return 0;
-
-        return m_queue_info->queue_size;
+        if (shared)
+            counter.fetch_add(value, std::memory_order_relaxed);
+        else
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
     }
 
-    uint32_t GetFreeSize() const
+    // tail    ȣ Ѵ. 踦      ũ⸦  ִ   Ѵ.
+    void RecordPush(uint64_t count, uint64_t bytes, uint64_t tail)
     {
-        if (!m_queue_info)
-            return 0;
+        if (m_persistent)
+            PendSync(count, bytes, true);
+
+        if (nullptr == m_statistics)
+            return;
 
-        return (m_queue_info->queue_size - sizeof(uint8_t)) - m_queue_info->use_size;
+        uint64_t use_size = 0;
+        if (QUEUE_MODE_MPMC == m_mode)
+        {
+            // ٸ Producer  Message   head   տ   ִ.
+            uint64_t head = m_queue_info->head.load(std::memory_order_relaxed);
+            use_size = (tail > head) ? (tail - head) * m_slot_size : 0;
+        }
+        else
+        {
+            //  ϴ ġ  ũ   Ŭ  Ƿ ϵ ִ    Consumer  ġ ٽ д´.
+            // Consumer    ִٸ Push  Consumer  Cache line   ʴ´.
+            uint64_t head = m_overwrite ? m_oldest : m_cached_head;
+            if (tail - head > m_statistics->high_water_size.load(std::memory_order_relaxed))
+            {
+                uint64_t consumer_head = LoadConsumerHead(tail, tail);
+                if (false == m_overwrite)
+                    m_cached_head = consumer_head;
+
+                // overwrite_oldest   Consumer  ġ ̹      ִ.
+                if (consumer_head > head)
+                    head = consumer_head;
+            }
+
+            use_size = tail - head;
+        }
+
+        bool shared = (QUEUE_MODE_MPMC == m_mode);
+        AddCounter(m_statistics->push_count, count, shared);
+        AddCounter(m_statistics->push_bytes, bytes, shared);
+
+        uint64_t high_water_size = m_statistics->high_water_size.load(std::memory_order_relaxed);
+        while (use_size > high_water_size &&
+               false == m_statistics->high_water_size.compare_exchange_weak(high_water_size, use_size, std::memory_order_relaxed))
+        {
+        }
     }
 
-    uint32_t GetWinErrorCode() const
+    void RecordPushFull()
     {
-        return m_error_code;
+        if (m_statistics && false == m_waiting)
+            AddCounter(m_statistics->push_full_count, 1, QUEUE_MODE_MPMC == m_mode);
     }
-};
 
-//////////////////////////////////////////////////////////////////////////
-
-CQueueSharedMemory::CQueueSharedMemory()
-    : m_impl(new CQueueSharedMemoryImpl)
-{
+    void RecordPop(uint64_t count, uint64_t bytes)
+    {
+        if (m_persistent)
+            PendSync(count, bytes, false);
 
-}
+        if (nullptr == m_statistics)
+            return;
 
-CQueueSharedMemory::~CQueueSharedMemory()
-{
-    Finalize();
-}
+        bool shared = (QUEUE_MODE_SPSC != m_mode);
+        AddCounter(m_statistics->pop_count, count, shared);
+        AddCounter(m_statistics->pop_bytes, bytes, shared);
+    }
 
-int CQueueSharedMemory::Initialize(const std::string& name, uint32_t queue_size)
-{
-    return m_impl->Initialize(name, queue_size);
-}
+    // sync_policy   Ͽ    ̶  Ѵ.
+    void PendSync(uint64_t count, uint64_t bytes, bool pushed)
+    {
+        m_sync_messages += count;
+        m_sync_bytes += bytes;
+        m_sync_pushed = m_sync_pushed || pushed;
 
-void CQueueSharedMemory::Finalize()
+        bool sync = false;
+        switch (m_sync_policy)
+        {
+        case SYNC_EVERY_MESSAGES:
+            sync = (m_sync_messages >= m_sync_threshold);
+            break;
+        case SYNC_EVERY_BYTES:
+            sync = (m_sync_bytes >= m_sync_threshold);
+            break;
+        case SYNC_INTERVAL:
+            sync = (std::chrono::steady_clock::now() - m_sync_time >= std::chrono::milliseconds(m_sync_threshold));
+            break;
+        default:
+            break;
+        }
+
+        // Push / Pop  ̹ Ϸ ǾǷ д GetWinErrorCode() θ .
+        if (sync)
+            SyncFile();
+    }
+
+    //    Push    head / tail  ִ QueueInfo  Ͽ  Ѵ.
+    // ͸   Ͽ tail  ϵǰ ʹ Ҿ 츦 δ.
+    int SyncFile()
+    {
+        bool flushed = true;
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_acquire);
+        if (m_sync_pushed)
+        {
+            // QUEUE_MODE_MPMC  ġ Slot  ̴.
+            uint64_t unit = (QUEUE_MODE_MPMC == m_mode) ? m_slot_size : 1;
+            uint64_t count = (QUEUE_MODE_MPMC == m_mode) ? m_slot_count : m_queue_info->queue_size;
+            uint64_t offset = m_queue_info->buffer_offset;
+            uint64_t span = tail - m_sync_tail;
+            if (span >= count)
+                flushed = m_shared_memory.Flush(offset, count * unit);
+            else if (span)
+            {
+                // Queue   Ѿ ٸ 0    Ѵ.
+                uint64_t pos = m_sync_tail % count;
+                uint64_t first = (span < count - pos) ? span : count - pos;
+                flushed = m_shared_memory.Flush(offset + pos * unit, first * unit) &&
+                          (first == span || m_shared_memory.Flush(offset, (span - first) * unit));
+            }
+        }
+
+        flushed = flushed && m_shared_memory.Flush(0, m_queue_info->buffer_offset);
+
+        m_sync_tail = tail;
+        m_sync_messages = 0;
+        m_sync_bytes = 0;
+        m_sync_pushed = false;
+        m_sync_time = std::chrono::steady_clock::now();
+
+        if (false == flushed)
+        {
+            m_error_code = m_shared_memory.GetErrorCode();
+            return SYNC_FAILED;
+        }
+
+        return 0;
+    }
+
+    //   ߴ μ    ٽ   ȣ Ѵ.
+    // head / tail  ʹ ״  ϰ  μ   /  /   Slot   Ѵ.
+    void RecoverQueue()
+    {
+        uint64_t head = m_queue_info->head.load(std::memory_order_relaxed);
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_relaxed);
+
+        m_queue_info->data_waiters.store(0, std::memory_order_relaxed);
+        m_queue_info->space_waiters.store(0, std::memory_order_relaxed);
+        m_queue_info->claim.store(tail, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < m_consumer_count; i++)
+            m_cursors[i].state.store(CURSOR_FREE, std::memory_order_relaxed);
+
+        //  ߿  Ǿٸ д  ٸ ʵ ⸦ .
+        m_queue_info->user_space_sequence.store((m_queue_info->user_space_sequence.load(std::memory_order_relaxed) + 1) & ~1u, std::memory_order_relaxed);
+        if (m_snapshot)
+            m_snapshot->sequence.store((m_snapshot->sequence.load(std::memory_order_relaxed) + 1) & ~(uint64_t)1, std::memory_order_relaxed);
+
+        if (QUEUE_MODE_MPMC != m_mode)
+            return;
+
+        // [head, tail)  Slot  Ͱ ְ   ־ Ѵ.
+        //      Slot   0  Message   Ͽ Consumer  Ѿ  ְ Ѵ.
+        for (uint64_t pos = head; pos < head + m_slot_count; pos++)
+        {
+            SlotHeader* slot = GetSlot(pos);
+            if (pos >= tail)
+                slot->sequence.store(pos, std::memory_order_relaxed);
+            else if (pos + 1 != slot->sequence.load(std::memory_order_relaxed))
+            {
+                slot->length = 0;
+                slot->sequence.store(pos + 1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    int CheckWritable() const
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+        if (m_read_only)
+            return READ_ONLY_QUEUE;
+
+        return 0;
+    }
+
+    // try_func   ϰų retry_code ̿  return     Ѵ.
+    // ó õ  ϸ wait_count   Ű   õ 迡  ʴ´.
+    template <typename TryFunc>
+    int WaitFor(TryFunc try_func, int retry_code, CSharedEvent& event,
+        std::atomic<uint32_t>& event_word, std::atomic<uint32_t>& waiters, uint32_t timeout_ms,
+        std::atomic<uint64_t> QueueStatistics::* wait_count)
+    {
+        int ret = try_func();
+        if (retry_code != ret)
+            return ret;
+
+        if (m_statistics)
+            (m_statistics->*wait_count).fetch_add(1, std::memory_order_relaxed);
+
+        m_waiting = true;
+        ret = WaitRetry(try_func, retry_code, event, event_word, waiters, timeout_ms);
+        m_waiting = false;
+
+        return ret;
+    }
+
+    // spin (pause) -> yield -> event   ܰ  Ѵ.
+    template <typename TryFunc>
+    int WaitRetry(TryFunc try_func, int retry_code, CSharedEvent& event,
+        std::atomic<uint32_t>& event_word, std::atomic<uint32_t>& waiters, uint32_t timeout_ms)
+    {
+        int ret = 0;
+        for (uint32_t i = 0; i < WAIT_SPIN_COUNT + WAIT_YIELD_COUNT; i++)
+        {
+            if (i < WAIT_SPIN_COUNT)
+                CSharedEvent::CpuRelax();
+            else
+                std::this_thread::yield();
+
+            ret = try_func();
+            if (retry_code != ret)
+                return ret;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        while (true)
+        {
+            uint32_t wait_ms = CSharedEvent::WAIT_FOREVER;
+            if (CSharedEvent::WAIT_FOREVER != timeout_ms)
+            {
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed >= timeout_ms)
+                    return TIMEOUT_EXPIRED;
+
+                wait_ms = timeout_ms - (uint32_t)elapsed;
+            }
+
+            //   а waiters    ٽ Ȯ ؾ   Wake()  ġ ʴ´.
+            uint32_t expected = event_word.load(std::memory_order_acquire);
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+
+            ret = try_func();
+            if (retry_code == ret)
+                event.Wait(expected, wait_ms);
+
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (retry_code != ret)
+                return ret;
+
+            ret = try_func();
+            if (retry_code != ret)
+                return ret;
+        }
+    }
+
+    SlotHeader* GetSlot(uint64_t pos) const
+    {
+        return reinterpret_cast<SlotHeader*>(&m_queue_buffer[(pos % m_slot_count) * m_slot_size]);
+    }
+
+    // tail  CAS    Slot ϳ  Ѵ.
+    int ReserveSlot(uint32_t buffer_len, uint8_t** buffer)
+    {
+        if (buffer_len > m_slot_size - sizeof(SlotHeader))
+            return NOT_ENOUGH_FREE_SPACE;
+
+        uint64_t pos = m_queue_info->tail.load(std::memory_order_relaxed);
+        SlotHeader* slot = nullptr;
+        while (true)
+        {
+            slot = GetSlot(pos);
+            int64_t diff = (int64_t)(slot->sequence.load(std::memory_order_acquire) - pos);
+            if (0 == diff)
+            {
+                if (m_queue_info->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return NOT_ENOUGH_FREE_SPACE;       // Consumer     Slot
+            else
+                pos = m_queue_info->tail.load(std::memory_order_relaxed);
+        }
+
+        slot->length = buffer_len;
+        m_reserve_slot = slot;
+        m_reserve_tail = pos;
+        *buffer = reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader);
+
+        return 0;
+    }
+
+    int CommitSlot()
+    {
+        if (nullptr == m_reserve_slot)
+            return DID_NOT_RESERVE;
+
+        // sequence  ؾ Consumer  ͸   ִ.
+        uint32_t length = m_reserve_slot->length;
+        m_reserve_slot->sequence.store(m_reserve_tail + 1, std::memory_order_release);
+        m_reserve_slot = nullptr;
+        NotifyData();
+
+        RecordPush(1, length, m_reserve_tail + 1);
+
+        return 0;
+    }
+
+    // head  CAS    Ͱ ִ Slot ϳ  Ѵ.
+    int PeekSlot(const uint8_t** buffer, uint32_t* buffer_len, uint32_t max_len)
+    {
+        uint64_t pos = m_queue_info->head.load(std::memory_order_relaxed);
+        SlotHeader* slot = nullptr;
+        while (true)
+        {
+            slot = GetSlot(pos);
+            int64_t diff = (int64_t)(slot->sequence.load(std::memory_order_acquire) - (pos + 1));
+            if (0 == diff)
+            {
+                //  ϱ  ̸ Ȯؾ   Message  Ҿ ʴ´.
+                if (slot->length > max_len)
+                {
+                    *buffer_len = slot->length;
+                    return READ_BUFFER_SIZE_IS_SMALL;
+                }
+
+                if (m_queue_info->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return POP_DATA_EMPTY;
+            else
+                pos = m_queue_info->head.load(std::memory_order_relaxed);
+        }
+
+        m_peek_slot = slot;
+        m_peek_head = pos;
+        *buffer = reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader);
+        *buffer_len = slot->length;
+
+        return 0;
+    }
+
+    int ReleaseSlot()
+    {
+        if (nullptr == m_peek_slot)
+            return POP_DATA_EMPTY;
+
+        //   Producer     ֵ sequence   Ѵ.
+        uint32_t length = m_peek_slot->length;
+        m_peek_slot->sequence.store(m_peek_head + m_slot_count, std::memory_order_release);
+        m_peek_slot = nullptr;
+        NotifySpace();
+        RecordPop(1, length);
+
+        return 0;
+    }
+
+    //  ִ ӵ Slot  ִ count   ѹ CAS   Ѵ.
+    int PushBatchSlot(const MessageBuffer* messages, uint32_t count, uint32_t* pushed_count)
+    {
+        // Slot   ʴ Message ձ ó Ѵ.
+        uint32_t max_len = m_slot_size - (uint32_t)sizeof(SlotHeader);
+        uint32_t batch_count = 0;
+        while (batch_count < count && messages[batch_count].buffer_len <= max_len)
+            batch_count++;
+
+        if (0 == batch_count)
+            return NOT_ENOUGH_FREE_SPACE;
+
+        uint64_t pos = m_queue_info->tail.load(std::memory_order_relaxed);
+        uint32_t claim_count = 0;
+        while (true)
+        {
+            int64_t diff = (int64_t)(GetSlot(pos)->sequence.load(std::memory_order_acquire) - pos);
+            if (diff < 0)
+                return NOT_ENOUGH_FREE_SPACE;
+            if (diff > 0)
+            {
+                pos = m_queue_info->tail.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            claim_count = 1;
+            while (claim_count < batch_count && GetSlot(pos + claim_count)->sequence.load(std::memory_order_acquire) == pos + claim_count)
+                claim_count++;
+
+            if (m_queue_info->tail.compare_exchange_weak(pos, pos + claim_count, std::memory_order_relaxed))
+                break;
+        }
+
+        uint64_t bytes = 0;
+        for (uint32_t i = 0; i < claim_count; i++)
+        {
+            SlotHeader* slot = GetSlot(pos + i);
+            slot->length = messages[i].buffer_len;
+            CSharedCopy::ToShared(reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader), messages[i].buffer, messages[i].buffer_len);
+            slot->sequence.store(pos + i + 1, std::memory_order_release);
+            bytes += messages[i].buffer_len;
+        }
+
+        NotifyData();
+
+        RecordPush(claim_count, bytes, pos + claim_count);
+
+        *pushed_count = claim_count;
+        return (claim_count == count) ? 0 : NOT_ENOUGH_FREE_SPACE;
+    }
+
+    // Ͱ ִ ӵ Slot  ִ max_count   ѹ CAS   Ѵ.
+    int PopBatchSlot(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count)
+    {
+        uint64_t pos = m_queue_info->head.load(std::memory_order_relaxed);
+        uint32_t claim_count = 0;
+        while (true)
+        {
+            int64_t diff = (int64_t)(GetSlot(pos)->sequence.load(std::memory_order_acquire) - (pos + 1));
+            if (diff < 0)
+                return POP_DATA_EMPTY;
+            if (diff > 0)
+            {
+                pos = m_queue_info->head.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            claim_count = 1;
+            while (claim_count < max_count && GetSlot(pos + claim_count)->sequence.load(std::memory_order_acquire) == pos + claim_count + 1)
+                claim_count++;
+
+            if (m_queue_info->head.compare_exchange_weak(pos, pos + claim_count, std::memory_order_relaxed))
+                break;
+        }
+
+        uint64_t bytes = 0;
+        for (uint32_t i = 0; i < claim_count; i++)
+        {
+            SlotHeader* slot = GetSlot(pos + i);
+            uint32_t length = slot->length;
+            callback(reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader), length);
+            slot->sequence.store(pos + i + m_slot_count, std::memory_order_release);
+            bytes += length;
+        }
+
+        NotifySpace();
+        RecordPop(claim_count, bytes);
+
+        *popped_count = claim_count;
+        return 0;
+    }
+
+    // tail ġ buffer_len  Message    Ȯϰ header  .
+    // tail   Ƿ  Message  ̾   ѹ    ִ.
+    int WriteHeader(uint64_t tail, uint32_t buffer_len, MessageHeader** message_header, uint64_t* next_tail)
+    {
+        uint64_t queue_size = m_queue_info->queue_size;
+        uint64_t record_size = sizeof(MessageHeader) + AlignMessage(buffer_len);
+        if (buffer_len > queue_size || record_size > queue_size)
+            return NOT_ENOUGH_FREE_SPACE;
+
+        //   0                                      queue_size
+        //   |--------------H************T--------------|
+        //                               |----------| <=== write_size
+        // write_size  Message  ũٸ  wrap marker   0   Ѵ.
+        // mirror  mapping Ǿ ִٸ  Ѿ ӵ ּ ̹Ƿ ״  Ѵ.
+        uint64_t pos = tail % queue_size;
+        uint64_t write_size = queue_size - pos;
+        uint64_t skip_size = (!m_mirror && write_size < record_size) ? write_size : 0;
+
+        uint64_t need_size = skip_size + record_size;
+        if (m_overwrite)
+        {
+            // Consumer  ġ  ʰ   Message    .
+            if (need_size > queue_size)
+                return NOT_ENOUGH_FREE_SPACE;
+            if (tail + need_size - m_oldest > queue_size)
+                DropOldest(tail + need_size);
+        }
+        else if (need_size > queue_size - (tail - m_cached_head))
+        {
+            m_cached_head = LoadConsumerHead(tail, tail + need_size);
+            if (need_size > queue_size - (tail - m_cached_head))
+                return NOT_ENOUGH_FREE_SPACE;
+        }
+
+        if (m_overrun)
+        {
+            //     ؾ Consumer    ȿ  Ȯ   ִ.
+            m_queue_info->claim.store(tail + need_size, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        if (skip_size)
+        {
+            reinterpret_cast<MessageHeader*>(&m_queue_buffer[pos])->length = MESSAGE_WRAP_MARKER;
+            pos = 0;
+        }
+
+        MessageHeader* header = reinterpret_cast<MessageHeader*>(&m_queue_buffer[pos]);
+        header->length = buffer_len;
+        header->sequence = (uint32_t)m_push_sequence;
+
+        *message_header = header;
+        *next_tail = tail + need_size;
+
+        return 0;
+    }
+
+    static uint64_t AlignUp(uint64_t value, uint64_t align)
+    {
+        return (value + align - 1) / align * align;
+    }
+
+    bool CreateSharedMemory(uint64_t queue_size, const InitOption& option)
+    {
+        if (0 == queue_size)
+            return false;
+
+        uint32_t flags = 0;
+        uint64_t consumer_count = 0;
+        if (QUEUE_MODE_BROADCAST == option.mode)
+        {
+            if (0 == option.max_consumers)
+                return false;
+
+            consumer_count = option.max_consumers;
+            if (option.overrun_laggards)
+                flags |= QUEUE_FLAG_OVERRUN;
+        }
+        else if (QUEUE_MODE_SPSC == option.mode && option.overwrite_oldest)
+            flags |= QUEUE_FLAG_OVERRUN;
+
+        // ConsumerCursor  QueueStatistics  QueueInfo    ̿ д.
+        uint64_t buffer_offset = sizeof(QueueInfo) + consumer_count * sizeof(ConsumerCursor);
+        if (option.statistics)
+        {
+            buffer_offset += sizeof(QueueStatistics);
+            flags |= QUEUE_FLAG_STATISTICS;
+        }
+        if (option.snapshot_size)
+        {
+            buffer_offset += sizeof(SnapshotInfo) + AlignUp(option.snapshot_size, 64);
+            flags |= QUEUE_FLAG_SNAPSHOT;
+        }
+        if (option.max_segments)
+            flags |= QUEUE_FLAG_GROWABLE;
+
+        uint64_t mirror_offset = 0;
+        uint64_t create_size = AlignUp(queue_size, MESSAGE_ALIGN);
+        if (option.mirror)
+        {
+            //   ۰ ũ⸦ mapping  .
+            uint64_t granularity = CSharedMemory::GetAllocationGranularity();
+            uint64_t header_size = CSharedMemory::GetHeaderSize();
+            buffer_offset = AlignUp(header_size + buffer_offset, granularity) - header_size;
+            create_size = AlignUp(create_size, granularity);
+            mirror_offset = buffer_offset;
+            flags |= QUEUE_FLAG_MIRROR;
+        }
+
+        uint64_t slot_size = 0;
+        uint64_t slot_count = 0;
+        if (QUEUE_MODE_MPMC == option.mode)
+        {
+            // ̿ Slot   Producer  Cache line   ʵ 64 Byte  .
+            slot_size = AlignUp(sizeof(SlotHeader) + (uint64_t)option.slot_size, 64);
+            slot_count = create_size / slot_size;
+            if (0 == option.slot_size || slot_count < 2)
+                return false;
+        }
+
+        if (slot_size > UINT32_MAX)
+            return false;
+
+        uint32_t create_flags = m_map_flags;
+        if (option.huge_pages && false == option.persistent)
+            create_flags |= CSharedMemory::CREATE_FLAG_HUGE_PAGES;
+        if (false == m_shared_memory.Create(m_name, buffer_offset + create_size, mirror_offset, create_flags))
+        {
+            m_error_code = m_shared_memory.GetErrorCode();
+            return false;
+        }
+
+        QueueInfo* queue_info = reinterpret_cast<QueueInfo*>(m_shared_memory.GetAddress());
+        queue_info->queue_size = create_size;
+        queue_info->flags = flags;
+        queue_info->buffer_offset = buffer_offset;
+        queue_info->mode = option.mode;
+        queue_info->slot_size = (uint32_t)slot_size;
+        queue_info->slot_count = slot_count;
+        queue_info->consumer_count = (uint32_t)consumer_count;
+        queue_info->max_segments = option.max_segments;
+        queue_info->snapshot_size = option.snapshot_size;
+
+        // ġ i  Slot  sequence  i    ִ.
+        uint8_t* queue_buffer = reinterpret_cast<uint8_t*>(queue_info) + buffer_offset;
+        for (uint64_t i = 0; i < slot_count; i++)
+            reinterpret_cast<SlotHeader*>(&queue_buffer[i * slot_size])->sequence.store(i, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    bool OpenSharedMemory()
+    {
+        if (false == m_shared_memory.Open(m_name, false, m_map_flags))
+        {
+            m_error_code = m_shared_memory.GetErrorCode();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GetSharedPoint()
+    {
+        if (m_shared_memory.GetSize() < sizeof(QueueInfo))
+            return false;
+
+        m_queue_info = reinterpret_cast<QueueInfo*>(m_shared_memory.GetAddress());
+        if (nullptr == m_queue_info)
+            return false;
+
+        if (QUEUE_INFO_MAGIC != m_queue_info->magic.load(std::memory_order_acquire) || QUEUE_INFO_VERSION != m_queue_info->version)
+            return false;
+
+        if (m_shared_memory.GetSize() < m_queue_info->buffer_offset + m_queue_info->queue_size)
+            return false;
+
+        //  Queue ġ QueueInfo  ִ.
+        m_queue_buffer = reinterpret_cast<uint8_t*>(m_queue_info) + m_queue_info->buffer_offset;
+        m_mirror = (0 != (m_queue_info->flags & QUEUE_FLAG_MIRROR));
+        m_mode = (QueueMode)m_queue_info->mode;
+        m_slot_size = m_queue_info->slot_size;
+        m_slot_count = m_queue_info->slot_count;
+        if (QUEUE_MODE_MPMC == m_mode && (uint64_t)m_slot_size * m_slot_count > m_queue_info->queue_size)
+            return false;
+
+        m_cursors = reinterpret_cast<ConsumerCursor*>(m_queue_info + 1);
+        m_consumer_count = m_queue_info->consumer_count;
+        m_overrun = (0 != (m_queue_info->flags & QUEUE_FLAG_OVERRUN));
+        m_overwrite = m_overrun && QUEUE_MODE_SPSC == m_mode;
+        m_max_segments = (m_queue_info->flags & QUEUE_FLAG_GROWABLE) ? m_queue_info->max_segments : 0;
+
+        uint64_t header_size = sizeof(QueueInfo) + (uint64_t)m_consumer_count * sizeof(ConsumerCursor);
+        m_statistics = nullptr;
+        if (m_queue_info->flags & QUEUE_FLAG_STATISTICS)
+        {
+            m_statistics = reinterpret_cast<QueueStatistics*>(reinterpret_cast<uint8_t*>(m_queue_info) + header_size);
+            header_size += sizeof(QueueStatistics);
+        }
+
+        m_snapshot = nullptr;
+        m_snapshot_buffer = nullptr;
+        m_snapshot_size = 0;
+        if (m_queue_info->flags & QUEUE_FLAG_SNAPSHOT)
+        {
+            m_snapshot = reinterpret_cast<SnapshotInfo*>(reinterpret_cast<uint8_t*>(m_queue_info) + header_size);
+            m_snapshot_buffer = reinterpret_cast<uint8_t*>(m_snapshot + 1);
+            m_snapshot_size = m_queue_info->snapshot_size;
+            header_size += sizeof(SnapshotInfo) + AlignUp(m_snapshot_size, 64);
+        }
+
+        if (m_queue_info->buffer_offset < header_size)
+            return false;
+
+        return true;
+    }
+
+    //   ü  ġ  Shared Memory    .
+    void ResetLocalState()
+    {
+        m_cursor = nullptr;
+        m_head = (QUEUE_MODE_BROADCAST == m_mode) ? nullptr : &m_queue_info->head;
+        m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+        m_cached_head = (QUEUE_MODE_BROADCAST == m_mode) ? m_cached_tail - m_queue_info->queue_size  // ó Reserve()  ٽ а Ѵ.
+                                                         : m_queue_info->head.load(std::memory_order_acquire);
+        m_oldest = m_queue_info->oldest.load(std::memory_order_acquire);
+        m_push_sequence = m_queue_info->sequence;
+        m_pop_sequence_valid = false;
+        m_lost_count = 0;
+        m_pop_data_len = 0;
+        m_reserve_header = nullptr;
+        m_peek_header = nullptr;
+        m_reserve_slot = nullptr;
+        m_peek_slot = nullptr;
+        m_waiting = false;
+        m_sync_tail = m_cached_tail;
+        m_sync_messages = 0;
+        m_sync_bytes = 0;
+        m_sync_pushed = false;
+        m_sync_time = std::chrono::steady_clock::now();
+    }
+
+    // Windows  Semaphore ̸ '\'     Ƿ   ڸ ٲ۴.
+    std::string GetEventName(const char* suffix) const
+    {
+        std::string name = m_name;
+        if (m_persistent)
+        {
+            for (char& c : name)
+            {
+                if ('\\' == c || '/' == c || ':' == c)
+                    c = '_';
+            }
+        }
+
+        return name + suffix;
+    }
+
+public:
+
+    CQueueSharedMemoryImpl()
+        : m_queue_info(nullptr)
+        , m_queue_buffer(nullptr)
+        , m_mirror(false)
+        , m_mode(QUEUE_MODE_SPSC)
+        , m_slot_size(0)
+        , m_slot_count(0)
+        , m_cursors(nullptr)
+        , m_consumer_count(0)
+        , m_overrun(false)
+        , m_cursor(nullptr)
+        , m_overwrite(false)
+        , m_oldest(0)
+        , m_push_sequence(0)
+        , m_pop_sequence(0)
+        , m_pop_sequence_valid(false)
+        , m_lost_count(0)
+        , m_statistics(nullptr)
+        , m_snapshot(nullptr)
+        , m_snapshot_buffer(nullptr)
+        , m_snapshot_size(0)
+        , m_map_flags(0)
+        , m_persistent(false)
+        , m_sync_policy(SYNC_NEVER)
+        , m_sync_threshold(0)
+        , m_sync_tail(0)
+        , m_sync_messages(0)
+        , m_sync_bytes(0)
+        , m_sync_pushed(false)
+        , m_read_only(false)
+        , m_max_segments(0)
+        , m_chain_first(0)
+        , m_read_segment{ 0, nullptr }
+        , m_waiting(false)
+        , m_head(nullptr)
+        , m_cached_head(0)
+        , m_cached_tail(0)
+        , m_reserve_header(nullptr)
+        , m_reserve_tail(0)
+        , m_peek_header(nullptr)
+        , m_peek_head(0)
+        , m_peek_len(0)
+        , m_reserve_slot(nullptr)
+        , m_peek_slot(nullptr)
+#ifdef _WIN32
+        , m_notify_event(nullptr)
+#else
+        , m_notify_fd(-1)
+#endif
+        , m_pop_data_len(0)
+        , m_error_code(0)
+    {
+
+    }
+
+    virtual ~CQueueSharedMemoryImpl()
+    {
+        Finalize();
+    }
+
+    int Initialize(const std::string& name, uint64_t queue_size, const InitOption& option)
+    {
+        Unsubscribe();
+        if (option.max_segments && (QUEUE_MODE_SPSC != option.mode || option.persistent || option.overwrite_oldest))
+            return NOT_SUPPORTED_MODE;
+        if (option.overwrite_oldest && QUEUE_MODE_SPSC != option.mode)
+            return NOT_SUPPORTED_MODE;
+
+        m_name = name;
+        m_read_only = false;
+        m_persistent = option.persistent;
+        m_sync_policy = option.sync_policy;
+        m_sync_threshold = option.sync_threshold;
+
+        m_map_flags = 0;
+        if (option.persistent)
+            m_map_flags |= CSharedMemory::CREATE_FLAG_FILE;
+        if (option.prefault)
+            m_map_flags |= CSharedMemory::CREATE_FLAG_PREFAULT;
+        if (option.lock_memory)
+            m_map_flags |= CSharedMemory::CREATE_FLAG_LOCK;
+        m_shared_memory.SetNumaNode(option.numa_node);
+
+        bool created = false;
+        if (false == OpenSharedMemory())
+        {
+            // ٸ μ   ߴٸ ٽ  .
+            if (CreateSharedMemory(queue_size, option))
+            {
+                //  ϴ  ʱȭ  QueueInfo   ʵ magic    Ѵ.
+                QueueInfo* queue_info = reinterpret_cast<QueueInfo*>(m_shared_memory.GetAddress());
+                queue_info->version = QUEUE_INFO_VERSION;
+                queue_info->magic.store(QUEUE_INFO_MAGIC, std::memory_order_release);
+                created = true;
+            }
+            else
+            {
+                uint32_t create_error = m_error_code;
+                if (false == OpenSharedMemory())
+                {
+                    // ̸ ̹ ־    찡 ƴ϶    .
+#ifdef _WIN32
+                    if (ERROR_ALREADY_EXISTS != create_error)
+#else
+                    if (EEXIST != create_error)
+#endif
+                        m_error_code = create_error;
+
+                    return CREATE_MAMORY_MAP_HANDLE;
+                }
+            }
+        }
+
+        if ((false == created && false == CSharedAttach::WaitReady(m_shared_memory)) || false == GetSharedPoint())
+        {
+            Finalize();
+            return BRING_QUEUE_INFO;
+        }
+
+        // Windows  File mapping   ̸    Ƿ ڿ ڸ δ.
+        if (false == m_data_event.Open(GetEventName("_DataEvent"), &m_queue_info->data_event) ||
+            false == m_space_event.Open(GetEventName("_SpaceEvent"), &m_queue_info->space_event))
+        {
+            Finalize();
+            return CREATE_MAMORY_MAP_HANDLE;
+        }
+
+        // ٸ    ٸ  ü  ϱ   μ   Ѵ.
+        if (m_shared_memory.IsExclusive())
+        {
+            if (false == created)
+                RecoverQueue();
+
+            m_shared_memory.ReleaseExclusive();
+        }
+
+        ResetLocalState();
+
+        return 0;
+    }
+
+    int InitializeReadOnly(const std::string& name)
+    {
+        Finalize();
+        m_name = name;
+
+        m_persistent = false;
+        m_map_flags = 0;
+        m_shared_memory.SetNumaNode(-1);
+        if (false == m_shared_memory.Open(m_name, true))
+        {
+            m_error_code = m_shared_memory.GetErrorCode();
+            return CREATE_MAMORY_MAP_HANDLE;
+        }
+
+        if (false == CSharedAttach::WaitReady(m_shared_memory) || false == GetSharedPoint())
+        {
+            Finalize();
+            return BRING_QUEUE_INFO;
+        }
+
+        // Queue    Ƿ Event   ʴ´.
+        m_read_only = true;
+        ResetLocalState();
+
+        return 0;
+    }
+
+    void Finalize()
+    {
+        //     ִٸ sync_policy    Ѵ.
+        if (m_persistent && m_queue_info && SYNC_NEVER != m_sync_policy && (m_sync_messages || m_sync_pushed))
+            SyncFile();
+
+        Unsubscribe();
+        CloseNotify();
+        m_write_segments.clear();
+        m_read_segment.queue.reset();
+        m_read_segment.index = 0;
+        m_max_segments = 0;
+        m_data_event.Close();
+        m_space_event.Close();
+        m_shared_memory.Close();
+        m_queue_info = nullptr;
+        m_queue_buffer = nullptr;
+        m_statistics = nullptr;
+        m_read_only = false;
+    }
+
+    std::string GetName() const
+    {
+        if (!m_queue_info)
+            return std::string();
+
+        return m_name;
+    }
+
+    // seqlock  .   ϳ ̸ д  ٸ ʴ´.
+    template <typename SequenceType, typename WriteFunc>
+    static void WriteSequenced(std::atomic<SequenceType>& sequence, WriteFunc write_func)
+    {
+        SequenceType begin = sequence.load(std::memory_order_relaxed) | 1;
+        sequence.store(begin, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        write_func();
+
+        sequence.store(begin + 1, std::memory_order_release);
+    }
+
+    // seqlock  б. д ߿ Ⱑ ־ٸ ٽ д´.
+    // read_func  false  return ϸ copy  ʰ .
+    //    ɸ spin (pause)  yield ϸ ٸ.
+    template <typename SequenceType, typename ReadFunc>
+    static SequenceType ReadSequenced(const std::atomic<SequenceType>& sequence, ReadFunc read_func)
+    {
+        for (uint32_t retry = 0;; retry++)
+        {
+            SequenceType begin = sequence.load(std::memory_order_acquire);
+            if (0 == (begin & 1))
+            {
+                bool copied = read_func(begin);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (false == copied || begin == sequence.load(std::memory_order_relaxed))
+                    return begin;
+            }
+
+            if (retry < WAIT_SPIN_COUNT)
+                CSharedEvent::CpuRelax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    int GetInformation(uint8_t* buffer)
+    {
+        if (!m_queue_info)
+            return DID_NOT_INITIALIZE;
+
+        ReadSequenced(m_queue_info->user_space_sequence, [&](uint32_t) {
+            memcpy(buffer, &m_queue_info->m_user_space[0], sizeof(m_queue_info->m_user_space));
+            return true;
+        });
+
+        return 0;
+    }
+
+    int SetInformation(uint8_t* buffer)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        WriteSequenced(m_queue_info->user_space_sequence, [&]() {
+            memcpy(&m_queue_info->m_user_space[0], buffer, sizeof(m_queue_info->m_user_space));
+        });
+
+        return 0;
+    }
+
+    int WriteSnapshot(const uint8_t* buffer, uint32_t buffer_len)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (nullptr == m_snapshot)
+            return SNAPSHOT_DISABLED;
+        if (buffer_len > m_snapshot_size)
+            return RANGE_IS_NOT_RIGHT;
+
+        WriteSequenced(m_snapshot->sequence, [&]() {
+            CSharedCopy::ToShared(m_snapshot_buffer, buffer, buffer_len);
+            m_snapshot->length.store(buffer_len, std::memory_order_relaxed);
+        });
+
+        return 0;
+    }
+
+    int ReadSnapshot(uint8_t* buffer, uint32_t buffer_len, uint32_t* snapshot_len, uint64_t* version)
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+        if (nullptr == m_snapshot)
+            return SNAPSHOT_DISABLED;
+
+        // version  ٸ copy  ʴ´. ó   version  0 ̴.
+        uint64_t known_version = *version;
+        uint32_t length = 0;
+        bool changed = false;
+        uint64_t sequence = ReadSequenced(m_snapshot->sequence, [&](uint64_t begin) {
+            changed = (begin / 2 != known_version);
+            length = m_snapshot->length.load(std::memory_order_relaxed);
+            if (false == changed || length > buffer_len || length > m_snapshot_size)
+                return false;
+
+            CSharedCopy::FromShared(buffer, m_snapshot_buffer, length);
+            return true;
+        });
+
+        if (0 == sequence)
+            return POP_DATA_EMPTY;
+        if (false == changed)
+            return SNAPSHOT_NOT_CHANGED;
+
+        *snapshot_len = length;
+        if (length > buffer_len)
+            return READ_BUFFER_SIZE_IS_SMALL;
+
+        *version = sequence / 2;
+
+        return 0;
+    }
+
+    uint64_t GetSnapshotVersion() const
+    {
+        if (nullptr == m_snapshot)
+            return 0;
+
+        return m_snapshot->sequence.load(std::memory_order_acquire) / 2;
+    }
+
+    int Clear()
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        // Producer      ȣ ؾ Ѵ.
+        if (QUEUE_MODE_MPMC == m_mode)
+        {
+            uint64_t tail = m_queue_info->tail.load(std::memory_order_acquire);
+            for (uint64_t pos = tail; pos < tail + m_slot_count; pos++)
+                GetSlot(pos)->sequence.store(pos, std::memory_order_relaxed);
+
+            m_queue_info->head.store(tail, std::memory_order_release);
+            m_reserve_slot = nullptr;
+            m_peek_slot = nullptr;
+            return 0;
+        }
+
+        memset(m_queue_buffer, 0, sizeof(uint8_t) * GetQueueSize());
+        // Message     ֵ 8 Byte  .
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_acquire);
+        m_cached_tail = (tail + (MESSAGE_ALIGN - 1)) & ~(uint64_t)(MESSAGE_ALIGN - 1);
+        m_queue_info->tail.store(m_cached_tail, std::memory_order_release);
+        m_queue_info->head.store(m_cached_tail, std::memory_order_release);
+        m_queue_info->claim.store(m_cached_tail, std::memory_order_release);
+        m_queue_info->oldest.store(m_cached_tail, std::memory_order_release);
+        for (uint32_t i = 0; i < m_consumer_count; i++)
+            m_cursors[i].position.store(m_cached_tail, std::memory_order_release);
+        m_cached_head = m_cached_tail;
+        m_oldest = m_cached_tail;
+        m_pop_data_len = 0;
+        m_reserve_header = nullptr;
+        m_peek_header = nullptr;
+
+        return 0;
+    }
+
+    int Push(uint8_t* buffer, uint32_t buffer_len)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        // overwrite_oldest  Message  ٽ ߹Ƿ Byte     .
+        if (QUEUE_MODE_SPSC != m_mode || m_overwrite)
+            return NOT_SUPPORTED_MODE;
+
+        // tail  Producer   ϹǷ relaxed  д´.
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_relaxed);
+        uint64_t queue_size = m_queue_info->queue_size;
+        if (buffer_len > queue_size - (tail - m_cached_head))
+        {
+            m_cached_head = m_queue_info->head.load(std::memory_order_acquire);
+            if (buffer_len > queue_size - (tail - m_cached_head))
+            {
+                RecordPushFull();
+                return NOT_ENOUGH_FREE_SPACE;
+            }
+        }
+
+        // --- :    *** :  
+        //   0                                      queue_size
+        //   |--------------H************T--------------|
+        //                               |----------| <=== write_size
+        uint64_t pos = tail % queue_size;
+        uint64_t write_size = queue_size - pos;
+        if (!m_mirror && write_size < buffer_len)
+        {
+            //   0                                      queue_size
+            //   |--------------H************T--------------|
+            //                               |--------------| <=== write_size Push
+            // Tail ڿ buffer  write_size ũ ŭ  Ѵ.
+            CSharedCopy::ToShared(&m_queue_buffer[pos], buffer, write_size);
+
+            //   0                                      queue_size
+            //   |--------------H************T--------------|
+            //   |-----------| <=== (buffer_len - write_size) Push
+            //  ͸  Ѵ.
+            CSharedCopy::ToShared(&m_queue_buffer[0], &buffer[write_size], buffer_len - write_size);
+        }
+        else
+        {
+            //   0                                      queue_size
+            //   |--------------H************T--------------|
+            //                               |----------|  <== buffer_len Push
+            CSharedCopy::ToShared(&m_queue_buffer[pos], buffer, buffer_len);
+        }
+
+        //  簡  Ŀ Consumer   Ѵ.
+        m_queue_info->tail.store(tail + buffer_len, std::memory_order_release);
+        NotifyData();
+        RecordPush(1, buffer_len, tail + buffer_len);
+
+        return 0;
+    }
+
+    int Front(uint8_t* buffer, uint32_t buffer_len)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (QUEUE_MODE_SPSC != m_mode || m_overwrite)
+            return NOT_SUPPORTED_MODE;
+
+        // head  Consumer   ϹǷ relaxed  д´.
+        uint64_t head = m_queue_info->head.load(std::memory_order_relaxed);
+        if (m_cached_tail - head < buffer_len)
+        {
+            m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+            if (m_cached_tail - head < buffer_len)
+                return READ_BUFFER_SIZE_IS_BIG;
+        }
+
+        // --- :    *** :  
+        //   0                                      queue_size
+        //   |**************T------------H**************|
+        //                               |----------| <=== read_size
+        uint64_t queue_size = m_queue_info->queue_size;
+        uint64_t pos = head % queue_size;
+        uint64_t read_size = queue_size - pos;
+        if (!m_mirror && read_size < buffer_len)
+        {
+            //   0                                      queue_size
+            //   |**************T------------H**************|
+            //                               |--------------| <=== read_size Pop
+            CSharedCopy::FromShared(buffer, &m_queue_buffer[pos], read_size);
+            //   0                                      queue_size
+            //   |**************T------------H**************|
+            //   |--------| <=== (buffer_len - read_size) Pop
+            CSharedCopy::FromShared(&buffer[read_size], &m_queue_buffer[0], buffer_len - read_size);
+        }
+        else
+        {
+            //   0                                      queue_size
+            //   |--------------H************T--------------|
+            //                  |----------| <=== buffer_len Pop
+            CSharedCopy::FromShared(buffer, &m_queue_buffer[pos], buffer_len);
+        }
+
+        m_pop_data_len = buffer_len;
+
+        return 0;
+    }
+
+    int Pop()
+    {
+        if (0 == m_pop_data_len)
+            return POP_DATA_EMPTY;
+
+        // ͸   Ŀ Producer    ش.
+        uint64_t head = m_queue_info->head.load(std::memory_order_relaxed);
+        m_queue_info->head.store(head + m_pop_data_len, std::memory_order_release);
+        NotifySpace();
+        RecordPop(1, m_pop_data_len);
+
+        m_pop_data_len = 0;
+
+        return 0;
+    }
+
+    int Reserve(uint32_t buffer_len, uint8_t** buffer)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        MessageHeader* header = nullptr;
+        if (QUEUE_MODE_MPMC == m_mode)
+            ret = ReserveSlot(buffer_len, buffer);
+        else
+            ret = WriteHeader(m_queue_info->tail.load(std::memory_order_relaxed), buffer_len, &header, &m_reserve_tail);
+
+        if (NOT_ENOUGH_FREE_SPACE == ret)
+            RecordPushFull();
+        if (ret || QUEUE_MODE_MPMC == m_mode)
+            return ret;
+
+        // Commit()  tail   Ƿ Consumer   ʴ´.
+        m_reserve_header = header;
+        *buffer = reinterpret_cast<uint8_t*>(header) + sizeof(MessageHeader);
+
+        return 0;
+    }
+
+    int Commit()
+    {
+        if (QUEUE_MODE_MPMC == m_mode)
+            return CommitSlot();
+
+        if (nullptr == m_reserve_header)
+            return DID_NOT_RESERVE;
+
+        uint32_t length = m_reserve_header->length;
+        if (m_overwrite)
+            m_queue_info->sequence = ++m_push_sequence;
+        m_queue_info->tail.store(m_reserve_tail, std::memory_order_release);
+        m_reserve_header = nullptr;
+        NotifyData();
+        RecordPush(1, length, m_reserve_tail);
+
+        return 0;
+    }
+
+    int PushMessage(const uint8_t* buffer, uint32_t buffer_len)
+    {
+        if (m_max_segments)
+            return PushGrowable(buffer, buffer_len);
+
+        return PushRing(buffer, buffer_len);
+    }
+
+    // overflow segment     ring  ߰ Ѵ.
+    int PushRing(const uint8_t* buffer, uint32_t buffer_len)
+    {
+        uint8_t* message = nullptr;
+        int ret = Reserve(buffer_len, &message);
+        if (ret)
+            return ret;
+
+        CSharedCopy::ToShared(message, buffer, buffer_len);
+
+        return Commit();
+    }
+
+    int Peek(const uint8_t** buffer, uint32_t* buffer_len, uint32_t max_len = UINT32_MAX)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        if (QUEUE_MODE_MPMC == m_mode)
+            return PeekSlot(buffer, buffer_len, max_len);
+
+        ret = CheckCursor();
+        if (ret)
+            return ret;
+
+        uint64_t head = m_head->load(std::memory_order_relaxed);
+        MessageHeader* header = FrontMessage(&head);
+        if (nullptr == header)
+            return POP_DATA_EMPTY;
+
+        uint32_t length = header->length;
+        uint32_t sequence = header->sequence;
+        ret = CheckOverwritten();
+        if (ret)
+            return ret;
+
+        CountLost(sequence);
+        if (length > max_len)
+        {
+            *buffer_len = length;
+            return READ_BUFFER_SIZE_IS_SMALL;
+        }
+
+        // Release()  head   Ƿ Producer    ʴ´.
+        // QUEUE_FLAG_OVERRUN ̸     Release()  Ȯ Ѵ.
+        m_peek_head = head + sizeof(MessageHeader) + AlignMessage(length);
+        m_peek_header = header;
+        m_peek_len = length;
+        *buffer = reinterpret_cast<uint8_t*>(header) + sizeof(MessageHeader);
+        *buffer_len = length;
+
+        return 0;
+    }
+
+    int Release()
+    {
+        if (QUEUE_MODE_MPMC == m_mode)
+            return ReleaseSlot();
+
+        if (nullptr == m_peek_header)
+            return POP_DATA_EMPTY;
+
+        int ret = CheckOverwritten();
+        if (ret)
+            return ret;
+
+        m_head->store(m_peek_head, std::memory_order_release);
+        m_peek_header = nullptr;
+        m_pop_sequence++;
+        NotifySpace();
+        RecordPop(1, m_peek_len);
+
+        return 0;
+    }
+
+    int PushWait(const uint8_t* buffer, uint32_t buffer_len, uint32_t timeout_ms)
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+
+        // Queue   ־    ũ ٸ ʴ´.
+        uint64_t queue_size = m_queue_info->queue_size;
+        if (buffer_len > queue_size || sizeof(MessageHeader) + AlignMessage(buffer_len) > queue_size)
+            return NOT_ENOUGH_FREE_SPACE;
+        if (QUEUE_MODE_MPMC == m_mode && buffer_len > m_slot_size - sizeof(SlotHeader))
+            return NOT_ENOUGH_FREE_SPACE;
+
+        return WaitFor([&]() { return PushMessage(buffer, buffer_len); }, NOT_ENOUGH_FREE_SPACE,
+            m_space_event, m_queue_info->space_event, m_queue_info->space_waiters, timeout_ms, &QueueStatistics::push_wait_count);
+    }
+
+    int PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms)
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+
+        return WaitFor([&]() { return PopMessage(buffer, buffer_len, message_len); }, POP_DATA_EMPTY,
+            m_data_event, m_queue_info->data_event, m_queue_info->data_waiters, timeout_ms, &QueueStatistics::pop_wait_count);
+    }
+
+    int PopBatchWait(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count, uint32_t timeout_ms)
+    {
+        *popped_count = 0;
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+
+        return WaitFor([&]() { return PopBatch(max_count, callback, popped_count); }, POP_DATA_EMPTY,
+            m_data_event, m_queue_info->data_event, m_queue_info->data_waiters, timeout_ms, &QueueStatistics::pop_wait_count);
+    }
+
+    int Subscribe()
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (QUEUE_MODE_BROADCAST != m_mode)
+            return NOT_SUPPORTED_MODE;
+        if (m_cursor)
+            return 0;
+
+        // ٸ μ  cursor   ʵ CAS   Ѵ.
+        for (uint32_t i = 0; i < m_consumer_count; i++)
+        {
+            uint32_t state = CURSOR_FREE;
+            if (m_cursors[i].state.compare_exchange_strong(state, CURSOR_CLAIMING))
+            {
+                m_cursor = &m_cursors[i];
+                m_head = &m_cursor->position;
+                ActivateCursor();
+                return 0;
+            }
+        }
+
+        return NOT_ENOUGH_CONSUMER_SLOT;
+    }
+
+    int OpenNotifyHandle(intptr_t* handle)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (QUEUE_MODE_BROADCAST == m_mode)
+            return NOT_SUPPORTED_MODE;
+
+#ifdef _WIN32
+        if (nullptr == m_notify_event)
+            m_notify_event = CreateEventA(nullptr, FALSE, FALSE, GetNotifyName().c_str());
+        if (nullptr == m_notify_event)
+        {
+            m_error_code = GetLastError();
+            return CREATE_MAMORY_MAP_HANDLE;
+        }
+
+        *handle = (intptr_t)m_notify_event;
+#else
+        if (m_notify_fd < 0)
+        {
+            std::string path = GetNotifyName();
+            if (0 != mkfifo(path.c_str(), 0666) && EEXIST != errno)
+            {
+                m_error_code = errno;
+                return CREATE_MAMORY_MAP_HANDLE;
+            }
+
+            // б /   Producer   POLLHUP   ʴ´.
+            m_notify_fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+            if (m_notify_fd < 0)
+            {
+                m_error_code = errno;
+                return CREATE_MAMORY_MAP_HANDLE;
+            }
+        }
+
+        *handle = m_notify_fd;
+#endif
+
+        return 0;
+    }
+
+    int ArmNotify()
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        // ׿ ִ ˸ .
+#ifdef _WIN32
+        if (nullptr == m_notify_event)
+            return DID_NOT_INITIALIZE;
+
+        ResetEvent((HANDLE)m_notify_event);
+#else
+        if (m_notify_fd < 0)
+            return DID_NOT_INITIALIZE;
+
+        uint8_t drain[64];
+        while (read(m_notify_fd, drain, sizeof(drain)) > 0)
+        {
+        }
+#endif
+
+        // notify_armed   Queue  Ȯ ؾ  ̿ Push  Producer  Message  ġ ʴ´.
+        m_queue_info->notify_armed.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (GetUseSize() && m_queue_info->notify_armed.exchange(0, std::memory_order_acq_rel))
+            SignalNotify();
+
+        return 0;
+    }
+
+    int Unsubscribe()
+    {
+        if (nullptr == m_cursor)
+            return DID_NOT_SUBSCRIBE;
+
+        m_cursor->state.store(CURSOR_FREE, std::memory_order_release);
+        m_cursor = nullptr;
+        m_head = nullptr;
+        m_peek_header = nullptr;
+
+        //  Consumer  ٸ Producer  .
+        NotifySpace();
+
+        return 0;
+    }
+
+    int PeekMessageSize(uint32_t* message_len)
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+
+        if (QUEUE_MODE_MPMC == m_mode)
+        {
+            // ٸ Consumer     Ƿ   ̴.
+            uint64_t pos = m_queue_info->head.load(std::memory_order_relaxed);
+            SlotHeader* slot = GetSlot(pos);
+            if (slot->sequence.load(std::memory_order_acquire) != pos + 1)
+                return POP_DATA_EMPTY;
+
+            *message_len = slot->length;
+            return 0;
+        }
+
+        int ret = CheckCursor();
+        if (ret)
+            return ret;
+
+        uint64_t head = m_head->load(std::memory_order_relaxed);
+        MessageHeader* header = FrontMessage(&head);
+        if (nullptr == header)
+            return POP_DATA_EMPTY;
+
+        uint32_t length = header->length;
+        ret = CheckOverwritten();
+        if (ret)
+            return ret;
+
+        *message_len = length;
+
+        return 0;
+    }
+
+    int PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
+    {
+        if (m_max_segments)
+            return PopGrowable(buffer, buffer_len, message_len);
+
+        return PopRing(buffer, buffer_len, message_len);
+    }
+
+    // overflow segment     ring  .
+    int PopRing(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
+    {
+        const uint8_t* message = nullptr;
+        int ret = Peek(&message, message_len, buffer_len);
+        if (ret)
+            return ret;
+
+        CSharedCopy::FromShared(buffer, message, *message_len);
+
+        return Release();
+    }
+
+    int PushMessage(const MessageBuffer* fragments, uint32_t fragment_count)
+    {
+        uint64_t message_len = 0;
+        for (uint32_t i = 0; i < fragment_count; i++)
+            message_len += fragments[i].buffer_len;
+
+        if (message_len > UINT32_MAX)
+            return NOT_ENOUGH_FREE_SPACE;
+
+        uint8_t* message = nullptr;
+        int ret = Reserve((uint32_t)message_len, &message);
+        if (ret)
+            return ret;
+
+        for (uint32_t i = 0; i < fragment_count; i++)
+        {
+            CSharedCopy::ToShared(message, fragments[i].buffer, fragments[i].buffer_len);
+            message += fragments[i].buffer_len;
+        }
+
+        return Commit();
+    }
+
+    int PushBatch(const MessageBuffer* messages, uint32_t count, uint32_t* pushed_count)
+    {
+        *pushed_count = 0;
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (0 == count)
+            return 0;
+
+        if (QUEUE_MODE_MPMC == m_mode)
+        {
+            ret = PushBatchSlot(messages, count, pushed_count);
+            if (NOT_ENOUGH_FREE_SPACE == ret)
+                RecordPushFull();
+
+            return ret;
+        }
+
+        //  Message    tail  ѹ  Ѵ.
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_relaxed);
+        uint64_t bytes = 0;
+        uint32_t batch_count = 0;
+        for (; batch_count < count; batch_count++)
+        {
+            MessageHeader* header = nullptr;
+            ret = WriteHeader(tail, messages[batch_count].buffer_len, &header, &tail);
+            if (ret)
+                break;
+
+            CSharedCopy::ToShared(reinterpret_cast<uint8_t*>(header) + sizeof(MessageHeader), messages[batch_count].buffer, messages[batch_count].buffer_len);
+            bytes += messages[batch_count].buffer_len;
+
+            //    Message   ϹǷ ϳ  Ѵ.
+            if (m_overwrite)
+            {
+                m_queue_info->sequence = ++m_push_sequence;
+                m_queue_info->tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        if (batch_count)
+        {
+            m_queue_info->tail.store(tail, std::memory_order_release);
+            NotifyData();
+            RecordPush(batch_count, bytes, tail);
+        }
+
+        if (NOT_ENOUGH_FREE_SPACE == ret)
+            RecordPushFull();
+
+        *pushed_count = batch_count;
+        return ret;
+    }
+
+    int PopBatch(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count)
+    {
+        *popped_count = 0;
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (0 == max_count)
+            return 0;
+
+        if (QUEUE_MODE_MPMC == m_mode)
+            return PopBatchSlot(max_count, callback, popped_count);
+
+        ret = CheckCursor();
+        if (ret)
+            return ret;
+
+        //  Message  callback  ѱ  head  ѹ  Ѵ.
+        uint64_t head = m_head->load(std::memory_order_relaxed);
+        uint64_t bytes = 0;
+        uint32_t batch_count = 0;
+        for (; batch_count < max_count; batch_count++)
+        {
+            MessageHeader* header = FrontMessage(&head);
+            if (nullptr == header)
+                break;
+
+            uint32_t length = header->length;
+            uint32_t sequence = header->sequence;
+            ret = CheckOverwritten();
+            if (ret)
+                return ret;
+
+            CountLost(sequence);
+            m_pop_sequence++;
+            callback(reinterpret_cast<uint8_t*>(header) + sizeof(MessageHeader), length);
+            head += sizeof(MessageHeader) + AlignMessage(length);
+            bytes += length;
+            *popped_count = batch_count + 1;
+        }
+
+        if (0 == batch_count)
+            return POP_DATA_EMPTY;
+
+        ret = CheckOverwritten();
+        if (ret)
+            return ret;
+
+        m_head->store(head, std::memory_order_release);
+        NotifySpace();
+        RecordPop(batch_count, bytes);
+
+        return 0;
+    }
+
+    int SetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len)
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+        if (pos < 0 || pos + buffer_len >= GetQueueSize())
+            return RANGE_IS_NOT_RIGHT;
+
+        CSharedCopy::ToShared(&m_queue_buffer[pos], buffer, buffer_len);
+
+        return 0;
+    }
+
+    int GetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len)
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+        if (pos < 0 || pos >= GetQueueSize())
+            return RANGE_IS_NOT_RIGHT;
+        if (GetQueueSize() - pos < buffer_len)
+            return RANGE_IS_NOT_RIGHT;
+
+        CSharedCopy::FromShared(buffer, &m_queue_buffer[pos], buffer_len);
+
+        return 0;
+    }
+
+    uint64_t GetUseSize() const
+    {
+        if (!m_queue_info)
+            return 0;
+
+        // head   о tail  Ŀ ʴ´.
+        uint64_t head = m_queue_info->head.load(std::memory_order_acquire);
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_acquire);
+
+        // QUEUE_MODE_BROADCAST  Subscribe() ߴٸ ڽ, ƴ϶   Consumer    Byte ũ
+        if (QUEUE_MODE_BROADCAST == m_mode)
+        {
+            head = tail;
+            for (uint32_t i = 0; i < m_consumer_count; i++)
+            {
+                const ConsumerCursor& cursor = m_cursors[i];
+                if (m_cursor && m_cursor != &cursor)
+                    continue;
+
+                uint64_t position = cursor.position.load(std::memory_order_acquire);
+                if (CURSOR_ACTIVE == cursor.state.load(std::memory_order_acquire) && position < head)
+                    head = position;
+            }
+        }
+
+        //    Consumer  Queue ũ⸦  ʰ Ѵ.
+        if (m_overrun && tail - head > m_queue_info->queue_size)
+            head = tail - m_queue_info->queue_size;
+
+        // QUEUE_MODE_MPMC    Slot  Byte ũ
+        if (QUEUE_MODE_MPMC == m_mode)
+            return (tail - head) * m_slot_size;
+
+        return tail - head;
+    }
+
+    uint64_t GetQueueSize() const
+    {
+        if (!m_queue_info)
+            return 0;
+
+        return m_queue_info->queue_size;
+    }
+
+    uint64_t GetFreeSize() const
+    {
+        if (!m_queue_info)
+            return 0;
+
+        return m_queue_info->queue_size - GetUseSize();
+    }
+
+    uint64_t GetLostCount() const
+    {
+        return m_lost_count;
+    }
+
+    bool IsHugePages() const
+    {
+        return m_shared_memory.IsHugePages();
+    }
+
+    int Sync()
+    {
+        int ret = CheckWritable();
+        if (ret)
+            return ret;
+
+        return SyncFile();
+    }
+
+    int GetStatistics(Statistics* statistics) const
+    {
+        if (nullptr == m_queue_info)
+            return DID_NOT_INITIALIZE;
+        if (nullptr == m_statistics)
+            return STATISTICS_DISABLED;
+
+        statistics->push_count = m_statistics->push_count.load(std::memory_order_relaxed);
+        statistics->push_bytes = m_statistics->push_bytes.load(std::memory_order_relaxed);
+        statistics->push_full_count = m_statistics->push_full_count.load(std::memory_order_relaxed);
+        statistics->push_wait_count = m_statistics->push_wait_count.load(std::memory_order_relaxed);
+        statistics->pop_count = m_statistics->pop_count.load(std::memory_order_relaxed);
+        statistics->pop_bytes = m_statistics->pop_bytes.load(std::memory_order_relaxed);
+        statistics->pop_wait_count = m_statistics->pop_wait_count.load(std::memory_order_relaxed);
+        statistics->high_water_size = m_statistics->high_water_size.load(std::memory_order_relaxed);
+
+        return 0;
+    }
+
+    uint32_t GetWinErrorCode() const
+    {
+        return m_error_code;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+CQueueSharedMemory::CQueueSharedMemory()
+    : m_impl(new CQueueSharedMemoryImpl)
+{
+
+}
+
+CQueueSharedMemory::~CQueueSharedMemory()
+{
+    Finalize();
+}
+
+int CQueueSharedMemory::Initialize(const std::string& name, uint64_t queue_size)
+{
+    return m_impl->Initialize(name, queue_size, InitOption());
+}
+
+int CQueueSharedMemory::Initialize(const std::string& name, uint64_t queue_size, const InitOption& option)
+{
+    return m_impl->Initialize(name, queue_size, option);
+}
+
+int CQueueSharedMemory::InitializeReadOnly(const std::string& name)
+{
+    return m_impl->InitializeReadOnly(name);
+}
+
+void CQueueSharedMemory::Finalize()
 {
     m_impl->Finalize();
 }
 
-std::string CQueueSharedMemory::GetName() const
-{
-    return m_impl->GetName();
-}
+std::string CQueueSharedMemory::GetName() const
+{
+    return m_impl->GetName();
+}
+
+int CQueueSharedMemory::GetInformation(uint8_t* buffer)
+{
+    return m_impl->GetInformation(buffer);
+}
+
+int CQueueSharedMemory::SetInformation(uint8_t* buffer)
+{
+    return m_impl->SetInformation(buffer);
+}
+
+int CQueueSharedMemory::WriteSnapshot(const uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->WriteSnapshot(buffer, buffer_len);
+}
+
+int CQueueSharedMemory::ReadSnapshot(uint8_t* buffer, uint32_t buffer_len, uint32_t* snapshot_len, uint64_t* version)
+{
+    return m_impl->ReadSnapshot(buffer, buffer_len, snapshot_len, version);
+}
+
+uint64_t CQueueSharedMemory::GetSnapshotVersion() const
+{
+    return m_impl->GetSnapshotVersion();
+}
+
+int CQueueSharedMemory::Clear()
+{
+    return m_impl->Clear();
+}
+
+int CQueueSharedMemory::Push(uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->Push(buffer, buffer_len);
+}
+
+int CQueueSharedMemory::Front(uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->Front(buffer, buffer_len);
+}
+
+int CQueueSharedMemory::Pop()
+{
+    return m_impl->Pop();
+}
+
+int CQueueSharedMemory::PushMessage(const uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->PushMessage(buffer, buffer_len);
+}
+
+int CQueueSharedMemory::PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
+{
+    return m_impl->PopMessage(buffer, buffer_len, message_len);
+}
+
+int CQueueSharedMemory::PushMessage(const MessageBuffer* fragments, uint32_t fragment_count)
+{
+    return m_impl->PushMessage(fragments, fragment_count);
+}
+
+int CQueueSharedMemory::PushBatch(const MessageBuffer* messages, uint32_t count, uint32_t* pushed_count)
+{
+    return m_impl->PushBatch(messages, count, pushed_count);
+}
+
+int CQueueSharedMemory::PopBatch(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count)
+{
+    return m_impl->PopBatch(max_count, callback, popped_count);
+}
+
+int CQueueSharedMemory::Reserve(uint32_t buffer_len, uint8_t** buffer)
+{
+    return m_impl->Reserve(buffer_len, buffer);
+}
+
+int CQueueSharedMemory::Commit()
+{
+    return m_impl->Commit();
+}
+
+int CQueueSharedMemory::Peek(const uint8_t** buffer, uint32_t* buffer_len)
+{
+    return m_impl->Peek(buffer, buffer_len);
+}
+
+int CQueueSharedMemory::Release()
+{
+    return m_impl->Release();
+}
+
+int CQueueSharedMemory::PushWait(const uint8_t* buffer, uint32_t buffer_len, uint32_t timeout_ms)
+{
+    return m_impl->PushWait(buffer, buffer_len, timeout_ms);
+}
+
+int CQueueSharedMemory::PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms)
+{
+    return m_impl->PopWait(buffer, buffer_len, message_len, timeout_ms);
+}
+
+int CQueueSharedMemory::PopBatchWait(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count, uint32_t timeout_ms)
+{
+    return m_impl->PopBatchWait(max_count, callback, popped_count, timeout_ms);
+}
+
+int CQueueSharedMemory::Subscribe()
+{
+    return m_impl->Subscribe();
+}
+
+int CQueueSharedMemory::Unsubscribe()
+{
+    return m_impl->Unsubscribe();
+}
+
+int CQueueSharedMemory::OpenNotifyHandle(intptr_t* handle)
+{
+    return m_impl->OpenNotifyHandle(handle);
+}
+
+int CQueueSharedMemory::ArmNotify()
+{
+    return m_impl->ArmNotify();
+}
+
+int CQueueSharedMemory::PeekMessageSize(uint32_t* message_len)
+{
+    return m_impl->PeekMessageSize(message_len);
+}
+
+int CQueueSharedMemory::SetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->SetData(pos, buffer, buffer_len);
+}
+
+int CQueueSharedMemory::GetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len)
+{
+    return m_impl->GetData(pos, buffer, buffer_len);
+}
+
+uint64_t CQueueSharedMemory::GetUseSize() const
+{
+    return m_impl->GetUseSize();
+}
+
+uint64_t CQueueSharedMemory::GetQueueSize() const
+{
+    return m_impl->GetQueueSize();
+}
+
+uint64_t CQueueSharedMemory::GetFreeSize() const
+{
+    return m_impl->GetFreeSize();
+}
+
+uint64_t CQueueSharedMemory::GetLostCount() const
+{
+    return m_impl->GetLostCount();
+}
+
+bool CQueueSharedMemory::IsHugePages() const
+{
+    return m_impl->IsHugePages();
+}
+
+int CQueueSharedMemory::Sync()
+{
+    return m_impl->Sync();
+}
+
+int CQueueSharedMemory::GetStatistics(Statistics* statistics) const
+{
+    return m_impl->GetStatistics(statistics);
+}
+
+uint32_t CQueueSharedMemory::GetWinErrorCode() const
+{
+    return m_impl->GetWinErrorCode();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Test Code
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+static CQueueTask TestProduceTask(CQueueExecutor& executor, CQueueSharedMemory& queue, uint32_t count, int* result)
+{
+    for (uint32_t i = 0; i < count && 0 == *result; i++)
+        *result = co_await PushAsync(executor, queue, (const uint8_t*)&i, sizeof(i));
+}
+
+static CQueueTask TestPushOnceTask(CQueueExecutor& executor, CQueueSharedMemory& queue, const uint8_t* buffer, uint32_t buffer_len, int* result)
+{
+    *result = co_await PushAsync(executor, queue, buffer, buffer_len);
+}
+
+static CQueueTask TestConsumeTask(CQueueExecutor& executor, CQueueSharedMemory& queue, uint32_t count, int* result)
+{
+    for (uint32_t i = 0; i < count && 0 == *result; i++)
+    {
+        uint32_t value = 0;
+        uint32_t message_len = 0;
+        *result = co_await PopAsync(executor, queue, (uint8_t*)&value, sizeof(value), &message_len);
+        if (0 == *result && i != value)
+            *result = -1;
+    }
+}
+#endif
+
+int TestQueueSharedMemory()
+{
+    std::string name = "MyFileMappingObject";
+    std::string str_send;
+    uint8_t buffer[32] = { 0, };
+
+    // ʱȭ
+    CQueueSharedMemory queue1;
+    if (queue1.Initialize(name, 128))
+        return 1;
+
+    CQueueSharedMemory queue2;
+    if (queue2.Initialize(name, 0))
+        return 2;
+
+    // Write
+    str_send = "hello world";
+    memcpy(buffer, str_send.c_str(), str_send.size());
+    queue1.Push(buffer, (uint32_t)str_send.size());
+
+    // Read
+    std::string str_recv;
+    queue2.Front(buffer, 11);
+    queue2.Pop();
+    str_recv = (char*)buffer;
+
+    // 
+    if (str_send != str_recv)
+        return 3;
+
+    // Queue   Ѿ ݺ Ѵ.
+    for (int i = 0; i < 100; i++)
+    {
+        memset(buffer, 0, sizeof(buffer));
+        memcpy(buffer, str_send.c_str(), str_send.size());
+        if (queue1.Push(buffer, (uint32_t)str_send.size()))
+            return 4;
+
+        memset(buffer, 0, sizeof(buffer));
+        if (queue2.Front(buffer, (uint32_t)str_send.size()) || queue2.Pop())
+            return 5;
+
+        if (str_send != (char*)buffer)
+            return 6;
+    }
+
+    if (0 != queue1.GetUseSize())
+        return 7;
+
+    if (queue2.Clear())
+        return 13;
+
+    // Message  Push / Pop. ̸ ٲ㰡 Queue  wrap marker  ġ Ѵ.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        uint32_t send_len = 1 + (i % sizeof(buffer));
+        memset(buffer, (int)i, send_len);
+        if (queue1.PushMessage(buffer, send_len))
+            return 8;
+
+        uint32_t message_len = 0;
+        if (queue2.PeekMessageSize(&message_len) || send_len != message_len)
+            return 9;
+
+        uint8_t recv[sizeof(buffer)] = { 0, };
+        if (queue2.PopMessage(recv, sizeof(recv), &message_len) || send_len != message_len)
+            return 10;
+
+        if (0 != memcmp(buffer, recv, send_len))
+            return 11;
+    }
+
+    uint32_t message_len = 0;
+    if (CQueueSharedMemory::POP_DATA_EMPTY != queue2.PopMessage(buffer, sizeof(buffer), &message_len))
+        return 12;
+
+    // Reserve / Commit  Shared Memory    Peek / Release   д´.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        uint8_t* write = nullptr;
+        if (queue1.Reserve((uint32_t)str_send.size(), &write))
+            return 14;
+
+        memcpy(write, str_send.c_str(), str_send.size());
+
+        const uint8_t* read = nullptr;
+        if (CQueueSharedMemory::POP_DATA_EMPTY != queue2.Peek(&read, &message_len))
+            return 15;
+
+        if (queue1.Commit())
+            return 16;
+
+        if (queue2.Peek(&read, &message_len) || str_send != std::string((const char*)read, message_len))
+            return 17;
+
+        if (queue2.Release())
+            return 18;
+    }
+
+    // mirror mapping : Queue   Ѿ Message  ϳ ӵ ּҷ д´.
+    CQueueSharedMemory::InitOption option;
+    option.mirror = true;
+
+    CQueueSharedMemory mirror1;
+    if (mirror1.Initialize(name + "Mirror", 128, option))
+        return 19;
+
+    CQueueSharedMemory mirror2;
+    if (mirror2.Initialize(name + "Mirror", 0))
+        return 20;
+
+    uint64_t mirror_size = mirror1.GetQueueSize();
+    std::string str_large((size_t)(mirror_size / 3), 'a');
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        str_large[i % str_large.size()] = (char)('b' + i);
+        if (mirror1.PushMessage((const uint8_t*)str_large.c_str(), (uint32_t)str_large.size()))
+            return 21;
+
+        const uint8_t* read = nullptr;
+        if (mirror2.Peek(&read, &message_len) || str_large != std::string((const char*)read, message_len))
+            return 22;
+
+        if (mirror2.Release())
+            return 23;
+    }
+
+    // PopWait / PushWait : ٸ thread  Push    ٰ .
+    if (CQueueSharedMemory::TIMEOUT_EXPIRED != queue2.PopWait(buffer, sizeof(buffer), &message_len, 10))
+        return 24;
+
+    std::thread producer([&]()
+    {
+        for (uint32_t i = 0; i < 1000; i++)
+            queue1.PushWait((const uint8_t*)&i, sizeof(i), CQueueSharedMemory::WAIT_FOREVER);
+    });
+
+    int wait_ret = 0;
+    for (uint32_t i = 0; i < 1000 && 0 == wait_ret; i++)
+    {
+        uint32_t value = 0;
+        if (queue2.PopWait((uint8_t*)&value, sizeof(value), &message_len, 5000) || value != i)
+            wait_ret = 25;
+    }
+
+    producer.join();
+    if (wait_ret)
+        return wait_ret;
+
+    // QUEUE_MODE_MPMC :  Producer / Consumer   Queue   Ѵ.
+    CQueueSharedMemory::InitOption mpmc_option;
+    mpmc_option.mode = CQueueSharedMemory::QUEUE_MODE_MPMC;
+    mpmc_option.slot_size = sizeof(uint64_t);
+
+    CQueueSharedMemory mpmc_queue;
+    if (mpmc_queue.Initialize(name + "Mpmc", 4096, mpmc_option))
+        return 26;
+
+    const uint64_t mpmc_count = 10000;
+    std::atomic<uint64_t> mpmc_sum(0);
+    std::atomic<uint64_t> mpmc_pop(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; i++)
+    {
+        // Producer :  ٸ ü  Queue   Ѵ.
+        workers.emplace_back([&, i]()
+        {
+            CQueueSharedMemory queue;
+            if (queue.Initialize(name + "Mpmc", 0))
+                return;
+
+            for (uint64_t value = i * mpmc_count + 1; value <= (i + 1) * mpmc_count; value++)
+                queue.PushWait((const uint8_t*)&value, sizeof(value), CQueueSharedMemory::WAIT_FOREVER);
+        });
+
+        // Consumer
+        workers.emplace_back([&]()
+        {
+            CQueueSharedMemory queue;
+            if (queue.Initialize(name + "Mpmc", 0))
+                return;
+
+            uint64_t value = 0;
+            uint32_t value_len = 0;
+            while (mpmc_pop.load() < 4 * mpmc_count)
+            {
+                if (0 == queue.PopWait((uint8_t*)&value, sizeof(value), &value_len, 10))
+                {
+                    mpmc_sum += value;
+                    mpmc_pop++;
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    uint64_t mpmc_total = 4 * mpmc_count;
+    if (mpmc_total * (mpmc_total + 1) / 2 != mpmc_sum.load() || 0 != mpmc_queue.GetUseSize())
+        return 27;
+
+    if (CQueueSharedMemory::NOT_SUPPORTED_MODE != mpmc_queue.Push(buffer, 1))
+        return 28;
+
+    // QUEUE_MODE_BROADCAST :  Consumer ΰ  Message  а   Consumer  ٸ.
+    CQueueSharedMemory::InitOption broadcast_option;
+    broadcast_option.mode = CQueueSharedMemory::QUEUE_MODE_BROADCAST;
+    broadcast_option.max_consumers = 2;
+
+    CQueueSharedMemory broadcast;
+    CQueueSharedMemory subscriber[3];
+    if (broadcast.Initialize(name + "Broadcast", 128, broadcast_option))
+        return 29;
+
+    for (auto& sub : subscriber)
+    {
+        if (sub.Initialize(name + "Broadcast", 0))
+            return 29;
+    }
+
+    if (CQueueSharedMemory::DID_NOT_SUBSCRIBE != subscriber[0].PopMessage(buffer, sizeof(buffer), &message_len))
+        return 30;
+
+    if (subscriber[0].Subscribe() || subscriber[1].Subscribe() ||
+        CQueueSharedMemory::NOT_ENOUGH_CONSUMER_SLOT != subscriber[2].Subscribe())
+        return 31;
+
+    // subscriber[1]   Ƿ Queue     ̻ Push   .
+    uint32_t broadcast_count = 0;
+    while (0 == broadcast.PushMessage((const uint8_t*)&broadcast_count, sizeof(broadcast_count)))
+    {
+        uint32_t value = 0;
+        if (subscriber[0].PopMessage((uint8_t*)&value, sizeof(value), &message_len) || value != broadcast_count)
+            return 32;
+
+        broadcast_count++;
+    }
+
+    for (uint32_t i = 0; i < broadcast_count; i++)
+    {
+        uint32_t value = 0;
+        if (subscriber[1].PopMessage((uint8_t*)&value, sizeof(value), &message_len) || value != i)
+            return 33;
+    }
+
+    //  cursor  ٸ Consumer     ְ,   Message  д´.
+    if (subscriber[1].Unsubscribe() || subscriber[2].Subscribe())
+        return 34;
 
-int CQueueSharedMemory::GetInformation(uint8_t* buffer)
-{
-    return m_impl->GetInformation(buffer);
-}
+    if (broadcast.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()))
+        return 35;
 
-int CQueueSharedMemory::SetInformation(uint8_t* buffer)
-{
-    return m_impl->SetInformation(buffer);
-}
+    for (int i : { 0, 2 })
+    {
+        const uint8_t* read = nullptr;
+        if (subscriber[i].Peek(&read, &message_len) || str_send != std::string((const char*)read, message_len) ||
+            subscriber[i].Release())
+            return 36;
+    }
 
-int CQueueSharedMemory::Clear()
-{
-    return m_impl->Clear();
-}
+    // overrun_laggards :  Consumer  ٸ ʰ    Consumer  ˸.
+    broadcast_option.overrun_laggards = true;
 
-int CQueueSharedMemory::Push(uint8_t* buffer, uint32_t buffer_len)
-{
-    return m_impl->Push(buffer, buffer_len);
-}
+    CQueueSharedMemory overrun;
+    CQueueSharedMemory overrun_subscriber;
+    if (overrun.Initialize(name + "Overrun", 128, broadcast_option) ||
+        overrun_subscriber.Initialize(name + "Overrun", 0) || overrun_subscriber.Subscribe())
+        return 37;
 
-int CQueueSharedMemory::Front(uint8_t* buffer, uint32_t buffer_len)
-{
-    return m_impl->Front(buffer, buffer_len);
-}
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        if (overrun.PushMessage((const uint8_t*)&i, sizeof(i)))
+            return 38;
+    }
 
-int CQueueSharedMemory::Pop()
-{
-    return m_impl->Pop();
-}
+    if (CQueueSharedMemory::CONSUMER_LAGGED != overrun_subscriber.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        CQueueSharedMemory::POP_DATA_EMPTY != overrun_subscriber.PopMessage(buffer, sizeof(buffer), &message_len))
+        return 39;
 
-int CQueueSharedMemory::SetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len)
-{
-    return m_impl->SetData(pos, buffer, buffer_len);
-}
+    if (overrun.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        overrun_subscriber.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        str_send != std::string((const char*)buffer, message_len))
+        return 40;
 
-int CQueueSharedMemory::GetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len)
-{
-    return m_impl->GetData(pos, buffer, buffer_len);
-}
+    // PushBatch / PopBatch :  Message  ѹ  Ѵ. 128 Byte Queue  16 Byte Message  8   .
+    uint32_t batch_values[10];
+    CQueueSharedMemory::MessageBuffer batch[10];
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        batch_values[i] = i;
+        batch[i].buffer = (const uint8_t*)&batch_values[i];
+        batch[i].buffer_len = sizeof(batch_values[i]);
+    }
 
-uint32_t CQueueSharedMemory::GetUseSize() const
-{
-    return m_impl->GetUseSize();
-}
+    uint32_t batch_count = 0;
+    if (CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != queue1.PushBatch(batch, 10, &batch_count) || 8 != batch_count)
+        return 41;
 
-uint32_t CQueueSharedMemory::GetQueueSize() const
-{
-    return m_impl->GetQueueSize();
-}
+    std::vector<uint32_t> batch_recv;
+    auto batch_callback = [&](const uint8_t* read, uint32_t read_len)
+    {
+        uint32_t value = 0;
+        if (sizeof(value) == read_len)
+            memcpy(&value, read, sizeof(value));
+        batch_recv.push_back(value);
+    };
 
-uint32_t CQueueSharedMemory::GetFreeSize() const
-{
-    return m_impl->GetFreeSize();
-}
+    if (queue2.PopBatch(5, batch_callback, &batch_count) || 5 != batch_count ||
+        queue2.PopBatch(64, batch_callback, &batch_count) || 3 != batch_count ||
+        CQueueSharedMemory::POP_DATA_EMPTY != queue2.PopBatch(64, batch_callback, &batch_count))
+        return 42;
 
-uint32_t CQueueSharedMemory::GetWinErrorCode() const
-{
-    return m_impl->GetWinErrorCode();
-}
+    // PopBatchWait : Message  ٸ ٸ  TIMEOUT_EXPIRED, ִٸ PopBatch()  .
+    if (CQueueSharedMemory::TIMEOUT_EXPIRED != queue2.PopBatchWait(64, batch_callback, &batch_count, 10) || 0 != batch_count ||
+        queue1.PushBatch(batch, 2, &batch_count) ||
+        queue2.PopBatchWait(64, batch_callback, &batch_count, 10) || 2 != batch_count)
+        return 42;
+    batch_recv.resize(8);
 
+    for (uint32_t i = 0; i < batch_recv.size(); i++)
+    {
+        if (8 != batch_recv.size() || i != batch_recv[i])
+            return 43;
+    }
 
-//////////////////////////////////////////////////////////////////////////
-// Test Code
+    //   ϳ Message  ̾ δ.
+    CQueueSharedMemory::MessageBuffer fragments[2] = { { (const uint8_t*)"hello ", 6 }, { (const uint8_t*)"world", 5 } };
+    if (queue1.PushMessage(fragments, 2) || queue2.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        str_send != std::string((const char*)buffer, message_len))
+        return 44;
 
-int TestQueueSharedMemory()
-{
-    std::string name = "MyFileMappingObject";
-    std::string str_send;
-    uint8_t buffer[32] = { 0, };
+    // QUEUE_MODE_MPMC  ӵ Slot  ѹ  Ѵ.
+    batch_recv.clear();
+    if (mpmc_queue.PushBatch(batch, 10, &batch_count) || 10 != batch_count ||
+        mpmc_queue.PopBatch(64, batch_callback, &batch_count) || 10 != batch_count)
+        return 45;
 
-    // ʱȭ
-    CQueueSharedMemory queue1;
-    if (queue1.Initialize(name, 128))
-        return 1;
+    for (uint32_t i = 0; i < batch_recv.size(); i++)
+    {
+        if (10 != batch_recv.size() || i != batch_recv[i])
+            return 46;
+    }
 
-    CQueueSharedMemory queue2;
-    if (queue2.Initialize(name, 0))
-        return 2;
+    // CTypedSharedQueue :  ũ struct  Slot   Ѵ.
+    struct TypedMessage
+    {
+        uint64_t    sequence;
+        double      value;
+    };
 
-    // Write
-    str_send = "hello world";
-    memcpy(buffer, str_send.c_str(), str_send.size());
-    queue1.Push(buffer, (uint32_t)str_send.size());
+    CTypedSharedQueue<TypedMessage, 8> typed_queue1;
+    CTypedSharedQueue<TypedMessage, 8> typed_queue2;
+    if (typed_queue1.Initialize(name + "Typed") || typed_queue2.Initialize(name + "Typed"))
+        return 47;
 
-    // Read
-    std::string str_recv;
-    queue2.Front(buffer, 11);
-    queue2.Pop();
-    str_recv = (char*)buffer;
+    // ٸ Capacity δ    .
+    CTypedSharedQueue<TypedMessage, 16> typed_mismatch;
+    if (CQueueSharedMemory::BRING_QUEUE_INFO != typed_mismatch.Initialize(name + "Typed"))
+        return 48;
 
-    // 
-    if (str_send != str_recv)
-        return 3;
+    for (uint64_t i = 0; i < 100; i++)
+    {
+        uint32_t push_count = 0;
+        while (typed_queue1.Push(TypedMessage{ i * 8 + push_count, 0.5 * push_count }))
+            push_count++;
+
+        if (8 != push_count || 8 != typed_queue2.GetUseCount())
+            return 49;
+
+        TypedMessage message = {};
+        for (uint32_t n = 0; n < push_count; n++)
+        {
+            if (false == typed_queue2.Pop(message) || i * 8 + n != message.sequence || 0.5 * n != message.value)
+                return 50;
+        }
+
+        if (typed_queue2.Pop(message))
+            return 51;
+    }
+
+    // huge_pages :     ȯ ̶ Ϲ page   ȴ.
+    CQueueSharedMemory::InitOption huge_option;
+    huge_option.huge_pages = true;
+
+    CQueueSharedMemory huge1;
+    CQueueSharedMemory huge2;
+    if (huge1.Initialize(name + "Huge", 1024 * 1024, huge_option) || huge2.Initialize(name + "Huge", 0))
+        return 52;
+
+    if (huge1.IsHugePages() != huge2.IsHugePages() || huge1.GetQueueSize() != huge2.GetQueueSize() ||
+        huge1.GetQueueSize() < 1024 * 1024)
+        return 53;
+
+    if (huge1.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        huge2.PopMessage(buffer, sizeof(buffer), &message_len) || str_send != std::string((const char*)buffer, message_len))
+        return 54;
+
+    // statistics : Push / Pop     Ǹ б   Ͽ   ִ.
+    CQueueSharedMemory::Statistics statistics = {};
+    if (CQueueSharedMemory::STATISTICS_DISABLED != huge1.GetStatistics(&statistics))
+        return 55;
+
+    CQueueSharedMemory::InitOption statistics_option;
+    statistics_option.statistics = true;
+
+    CQueueSharedMemory statistics1;
+    CQueueSharedMemory statistics2;
+    if (statistics1.Initialize(name + "Statistics", 64, statistics_option) || statistics2.Initialize(name + "Statistics", 0))
+        return 56;
+
+    // 24 Byte Message  header   Ͽ 32 Byte ̹Ƿ ΰ .
+    uint8_t statistics_message[24] = { 0, };
+    if (statistics1.PushMessage(statistics_message, sizeof(statistics_message)) ||
+        statistics1.PushMessage(statistics_message, sizeof(statistics_message)) ||
+        CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != statistics1.PushMessage(statistics_message, sizeof(statistics_message)))
+        return 57;
+
+    if (statistics2.PopMessage(buffer, sizeof(buffer), &message_len) || statistics2.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        CQueueSharedMemory::TIMEOUT_EXPIRED != statistics2.PopWait(buffer, sizeof(buffer), &message_len, 0))
+        return 58;
+
+    if (statistics2.GetStatistics(&statistics) ||
+        2 != statistics.push_count || 48 != statistics.push_bytes || 1 != statistics.push_full_count || 0 != statistics.push_wait_count ||
+        2 != statistics.pop_count || 48 != statistics.pop_bytes || 1 != statistics.pop_wait_count || 64 != statistics.high_water_size)
+        return 59;
+
+    // Consumer  Push  ٸ ִ  Message ϳ ũ ̴.
+    CQueueSharedMemory drain_producer;
+    CQueueSharedMemory drain_consumer;
+    if (drain_producer.Initialize(name + "StatisticsDrain", 1024, statistics_option) || drain_consumer.Initialize(name + "StatisticsDrain", 0))
+        return 59;
+
+    for (int i = 0; i < 100; i++)
+    {
+        if (drain_producer.PushMessage(statistics_message, sizeof(statistics_message)) ||
+            drain_consumer.PopMessage(buffer, sizeof(buffer), &message_len))
+            return 59;
+    }
+
+    CQueueSharedMemory::Statistics drain_statistics = {};
+    if (drain_consumer.GetStatistics(&drain_statistics) || 100 != drain_statistics.push_count || 32 != drain_statistics.high_water_size)
+        return 59;
+
+    drain_producer.Finalize();
+    drain_consumer.Finalize();
+
+    CQueueSharedMemory statistics_reader;
+    CQueueSharedMemory::Statistics reader_statistics = {};
+    if (statistics_reader.InitializeReadOnly(name + "Statistics") || statistics_reader.GetStatistics(&reader_statistics) ||
+        reader_statistics.push_count != statistics.push_count || reader_statistics.pop_bytes != statistics.pop_bytes)
+        return 60;
+
+    if (CQueueSharedMemory::READ_ONLY_QUEUE != statistics_reader.PushMessage(statistics_message, sizeof(statistics_message)) ||
+        CQueueSharedMemory::READ_ONLY_QUEUE != statistics_reader.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        0 != statistics_reader.GetUseSize())
+        return 61;
+
+    if (CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE != statistics_reader.InitializeReadOnly(name + "NotExist"))
+        return 62;
+
+    // persistent :  ü  Ŀ Ͽ  head / tail  ٽ  Ѵ.
+    std::string file_path = name + "Persistent.dat";
+    remove(file_path.c_str());
+
+    CQueueSharedMemory::InitOption persistent_option;
+    persistent_option.persistent = true;
+    persistent_option.sync_policy = CQueueSharedMemory::SYNC_EVERY_MESSAGES;
+    persistent_option.sync_threshold = 2;
+    {
+        CQueueSharedMemory persistent1;
+        CQueueSharedMemory persistent2;
+        if (persistent1.Initialize(file_path, 4096, persistent_option) || persistent2.Initialize(file_path, 0, persistent_option))
+            return 63;
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            std::string message = "persistent " + std::to_string(i);
+            if (persistent1.PushMessage((const uint8_t*)message.c_str(), (uint32_t)message.size()))
+                return 64;
+        }
+
+        if (persistent2.PopMessage(buffer, sizeof(buffer), &message_len) || "persistent 0" != std::string((const char*)buffer, message_len))
+            return 65;
+    }
+    {
+        CQueueSharedMemory persistent3;
+        if (persistent3.Initialize(file_path, 0, persistent_option) || 4096 != persistent3.GetQueueSize())
+            return 66;
+
+        for (uint32_t i = 1; i < 3; i++)
+        {
+            if (persistent3.PopMessage(buffer, sizeof(buffer), &message_len) ||
+                "persistent " + std::to_string(i) != std::string((const char*)buffer, message_len))
+                return 67;
+        }
+
+        if (CQueueSharedMemory::POP_DATA_EMPTY != persistent3.PopMessage(buffer, sizeof(buffer), &message_len) || persistent3.Sync())
+            return 68;
+    }
+
+    if (remove(file_path.c_str()))
+        return 69;
+
+    // persistent  : Commit()  ϰ  Slot   0  Message  Ǿ  Message    ִ.
+    persistent_option.mode = CQueueSharedMemory::QUEUE_MODE_MPMC;
+    persistent_option.slot_size = 32;
+    {
+        CQueueSharedMemory persistent4;
+        uint8_t* reserve_buffer = nullptr;
+        if (persistent4.Initialize(file_path, 4096, persistent_option) || persistent4.Reserve(8, &reserve_buffer) ||
+            persistent4.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()))
+            return 70;
+    }
+    {
+        CQueueSharedMemory persistent5;
+        if (persistent5.Initialize(file_path, 0, persistent_option) ||
+            persistent5.PopMessage(buffer, sizeof(buffer), &message_len) || 0 != message_len ||
+            persistent5.PopMessage(buffer, sizeof(buffer), &message_len) || str_send != std::string((const char*)buffer, message_len))
+            return 71;
+    }
+
+    remove(file_path.c_str());
+
+    // CShardedSharedQueue : Producer  ٸ Lane   Consumer   Lane  д´.
+    CShardedSharedQueue sharded_consumer;
+    CShardedSharedQueue sharded_producer1;
+    CShardedSharedQueue sharded_producer2;
+    CShardedSharedQueue sharded_producer3;
+    if (sharded_consumer.Initialize(name + "Sharded", 2, 256) || sharded_producer1.Initialize(name + "Sharded", 2, 256) ||
+        sharded_producer2.Initialize(name + "Sharded", 2, 256))
+        return 72;
+
+    CShardedSharedQueue sharded_mismatch;
+    if (CQueueSharedMemory::BRING_QUEUE_INFO != sharded_mismatch.Initialize(name + "Sharded", 4, 256))
+        return 73;
+
+    // Lane  2  ̹Ƿ ° Producer  Lane     .
+    if (sharded_producer1.AcquireLane() || sharded_producer2.AcquireLane() || sharded_producer1.GetLane() == sharded_producer2.GetLane() ||
+        sharded_producer3.Initialize(name + "Sharded", 2, 256) || CQueueSharedMemory::NOT_ENOUGH_LANE != sharded_producer3.AcquireLane())
+        return 74;
+
+    // Lane    wrap ǵ Push / Pop Ѵ.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        std::string message1 = "lane1-" + std::to_string(i);
+        std::string message2 = "lane2-" + std::to_string(i);
+        if (sharded_producer1.PushMessage((const uint8_t*)message1.c_str(), (uint32_t)message1.size()) ||
+            sharded_producer2.PushMessage((const uint8_t*)message2.c_str(), (uint32_t)message2.size()))
+            return 75;
+
+        // SHARD_POLICY_ROUND_ROBIN ̹Ƿ  Lane  Message  ϳ д´.
+        std::string pop1, pop2;
+        if (sharded_consumer.PopMessage(buffer, sizeof(buffer), &message_len))
+            return 76;
+        pop1.assign((const char*)buffer, message_len);
+        if (sharded_consumer.PopMessage(buffer, sizeof(buffer), &message_len))
+            return 76;
+        pop2.assign((const char*)buffer, message_len);
+
+        if (!((pop1 == message1 && pop2 == message2) || (pop1 == message2 && pop2 == message1)))
+            return 77;
+    }
+
+    if (CQueueSharedMemory::POP_DATA_EMPTY != sharded_consumer.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        0 != sharded_consumer.GetUseSize())
+        return 78;
+
+    // Lane  ȯ ϸ ٸ Producer  ̾   ִ.
+    sharded_producer1.ReleaseLane();
+    uint32_t sharded_popped = 0;
+    if (sharded_producer3.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        sharded_producer2.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        sharded_consumer.PopBatch(10, [&](const uint8_t* data, uint32_t len) {
+            if (str_send == std::string((const char*)data, len))
+                sharded_popped++;
+        }, &message_len) || 2 != message_len || 2 != sharded_popped)
+        return 79;
+
+    // sequence   ϸ Lane  ޶ Push   д´.
+    CShardedSharedQueue ordered_consumer;
+    CShardedSharedQueue ordered_producer1;
+    CShardedSharedQueue ordered_producer2;
+    if (ordered_consumer.Initialize(name + "Ordered", 2, 256, true) || ordered_producer1.Initialize(name + "Ordered", 2, 256, true) ||
+        ordered_producer2.Initialize(name + "Ordered", 2, 256, true))
+        return 80;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        CShardedSharedQueue& producer = (i % 3) ? ordered_producer2 : ordered_producer1;
+        if (producer.PushMessage((const uint8_t*)&i, sizeof(i)))
+            return 81;
+    }
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        uint32_t value = 0;
+        if (ordered_consumer.PopWait((uint8_t*)&value, sizeof(value), &message_len, 0) || i != value)
+            return 82;
+    }
+
+    if (CQueueSharedMemory::TIMEOUT_EXPIRED != ordered_consumer.PopWait(buffer, sizeof(buffer), &message_len, 10))
+        return 83;
+
+    // CPrioritySharedQueue :  켱  Message     켱  Message   д´.
+    CPrioritySharedQueue priority_producer;
+    CPrioritySharedQueue priority_consumer;
+    if (priority_producer.Initialize(name + "Priority", { 128, 1024 }) || priority_consumer.Initialize(name + "Priority", { 128, 1024 }))
+        return 84;
+
+    CPrioritySharedQueue priority_mismatch;
+    if (CQueueSharedMemory::BRING_QUEUE_INFO != priority_mismatch.Initialize(name + "Priority", { 1024, 1024 }))
+        return 85;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (priority_producer.PushMessage(1, (const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()))
+            return 86;
+    }
+
+    const std::string control = "cancel";
+    if (priority_producer.PushMessage(0, (const uint8_t*)control.c_str(), (uint32_t)control.size()) ||
+        0x03 != priority_consumer.GetReadyMask())
+        return 87;
+
+    uint32_t pop_priority = 0;
+    if (priority_consumer.PopMessage(buffer, sizeof(buffer), &message_len, &pop_priority) || 0 != pop_priority ||
+        control != std::string((const char*)buffer, message_len))
+        return 88;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (priority_consumer.PopWait(buffer, sizeof(buffer), &message_len, 0, &pop_priority) || 1 != pop_priority)
+            return 89;
+    }
+
+    if (CQueueSharedMemory::POP_DATA_EMPTY != priority_consumer.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        0 != priority_consumer.GetReadyMask())
+        return 90;
+
+    // ġ 2 : 1 ̸  켱  3   ϳ .
+    if (priority_consumer.SetWeights({ 2, 1 }))
+        return 91;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        if (priority_producer.PushMessage(0, (const uint8_t*)&i, sizeof(i)) ||
+            (i < 3 && priority_producer.PushMessage(1, (const uint8_t*)&i, sizeof(i))))
+            return 92;
+    }
+
+    for (uint32_t i = 0; i < 9; i++)
+    {
+        if (priority_consumer.PopMessage(buffer, sizeof(buffer), &message_len, &pop_priority) ||
+            (2 == i % 3 ? 1u : 0u) != pop_priority)
+            return 93;
+    }
+
+    // CSharedSlabPool : block    SlabHandle  Queue  ѱ.
+    CSharedSlabPool slab_producer;
+    CSharedSlabPool slab_consumer;
+    std::vector<CSharedSlabPool::SizeClass> size_classes = { { 256, 4 }, { 4096, 2 } };
+    if (slab_producer.Initialize(name + "Slab", size_classes) || slab_consumer.Initialize(name + "Slab", size_classes))
+        return 94;
+
+    CQueueSharedMemory handle_producer;
+    CQueueSharedMemory handle_consumer;
+    if (handle_producer.Initialize(name + "Handle", 1024) || handle_consumer.Initialize(name + "Handle", 0))
+        return 95;
+
+    CSharedSlabPool::SlabHandle slab_handle;
+    uint8_t* slab_data = nullptr;
+    if (slab_producer.Allocate(3000, &slab_handle, &slab_data) || 4096 != slab_producer.GetBlockSize(1) || 1 != slab_producer.GetFreeCount(1))
+        return 96;
+
+    memset(slab_data, 0x5A, 3000);
+    if (handle_producer.PushMessage((const uint8_t*)&slab_handle, sizeof(slab_handle)))
+        return 97;
+
+    CSharedSlabPool::SlabHandle pop_handle;
+    if (handle_consumer.PopMessage((uint8_t*)&pop_handle, sizeof(pop_handle), &message_len) || sizeof(pop_handle) != message_len)
+        return 98;
+
+    const uint8_t* slab_read = slab_consumer.GetAddress(pop_handle);
+    if (nullptr == slab_read || 3000 != pop_handle.length || 0x5A != slab_read[0] || 0x5A != slab_read[2999])
+        return 99;
+
+    // ȯ ѹ   ִ.
+    if (slab_consumer.Free(pop_handle) || CQueueSharedMemory::RANGE_IS_NOT_RIGHT != slab_consumer.Free(pop_handle) ||
+        2 != slab_consumer.GetFreeCount(1))
+        return 100;
+
+    //  class   ū class  Ҵ ϰ    Ѵ.
+    std::vector<CSharedSlabPool::SlabHandle> slab_handles(6);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        if (slab_producer.Allocate(100, &slab_handles[i]))
+            return 101;
+    }
+    if (CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != slab_producer.Allocate(100, &slab_handle) ||
+        nullptr == slab_producer.GetAddress(slab_handles[5]) || 0 != slab_producer.GetFreeCount(0))
+        return 102;
+
+    for (auto& allocated : slab_handles)
+    {
+        if (slab_consumer.Free(allocated))
+            return 103;
+    }
+
+    //  thread  ÿ Ҵ / ȯ ص block  ߺ ؼ  ʴ´.
+    std::atomic<uint32_t> slab_errors(0);
+    std::vector<std::thread> slab_threads;
+    for (uint32_t t = 0; t < 4; t++)
+    {
+        slab_threads.emplace_back([&, t]()
+        {
+            for (uint32_t i = 0; i < 10000; i++)
+            {
+                CSharedSlabPool::SlabHandle handle;
+                uint8_t* data = nullptr;
+                if (slab_producer.Allocate(8, &handle, &data))
+                    continue;
+
+                *(volatile uint32_t*)data = t;
+                std::this_thread::yield();
+                if (t != *(volatile uint32_t*)data || slab_producer.Free(handle))
+                    slab_errors++;
+            }
+        });
+    }
+    for (auto& thread : slab_threads)
+        thread.join();
+
+    if (slab_errors || 4 != slab_producer.GetFreeCount(0) || 2 != slab_producer.GetFreeCount(1))
+        return 104;
+
+    // ˸ handle : ArmNotify()  ó Push  ѹ   ִ ° ȴ.
+    CQueueSharedMemory notify_producer;
+    CQueueSharedMemory notify_consumer;
+    intptr_t notify_handle = 0;
+    if (notify_producer.Initialize(name + "Notify", 1024) || notify_consumer.Initialize(name + "Notify", 0) ||
+        notify_consumer.OpenNotifyHandle(&notify_handle) || notify_consumer.ArmNotify())
+        return 105;
+
+    auto is_notified = [&]() {
+#ifdef _WIN32
+        return WAIT_OBJECT_0 == WaitForSingleObject((HANDLE)notify_handle, 0);
+#else
+        uint8_t drain[64];
+        return read((int)notify_handle, drain, sizeof(drain)) > 0;
+#endif
+    };
+
+    if (is_notified())
+        return 106;
+
+    if (notify_producer.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        notify_producer.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        false == is_notified() || is_notified())
+        return 107;
+
+    //   Message  ִ · ArmNotify() ϸ ٷ ˸.
+    if (notify_consumer.PopMessage(buffer, sizeof(buffer), &message_len) || notify_consumer.ArmNotify() || false == is_notified())
+        return 108;
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    //  Queue  Producer   , Consumer   ߸ ϳ thread    ȴ.
+    CQueueSharedMemory coroutine_producer;
+    CQueueSharedMemory coroutine_consumer;
+    if (coroutine_producer.Initialize(name + "Coroutine", 64) || coroutine_consumer.Initialize(name + "Coroutine", 0))
+        return 109;
+
+    CQueueExecutor executor;
+    int produce_result = 0;
+    int consume_result = 0;
+    executor.Spawn(TestConsumeTask(executor, coroutine_consumer, 1000, &consume_result));
+    executor.Spawn(TestProduceTask(executor, coroutine_producer, 1000, &produce_result));
+    executor.Run();
+
+    if (produce_result || consume_result || executor.GetTaskCount() || coroutine_consumer.GetUseSize())
+        return 110;
+
+    // Queue  Ͱ ־     ʴ Message  ٸ ʰ  Ѵ.
+    uint32_t coroutine_value = 0;
+    uint8_t coroutine_large[100] = { 0, };
+    if (coroutine_producer.PushMessage((const uint8_t*)&coroutine_value, sizeof(coroutine_value)))
+        return 110;
+
+    executor.Spawn(TestPushOnceTask(executor, coroutine_producer, coroutine_large, sizeof(coroutine_large), &produce_result));
+    executor.Spawn(TestConsumeTask(executor, coroutine_consumer, 1, &consume_result));
+    executor.Run();
+
+    if (CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != produce_result || consume_result || executor.GetTaskCount())
+        return 110;
+#endif
+
+    // main ring    overflow segment  ̾ Consumer    д´.
+    CQueueSharedMemory::InitOption growable_option;
+    growable_option.max_segments = 4;
+    CQueueSharedMemory growable1;
+    CQueueSharedMemory growable2;
+    if (growable1.Initialize(name + "Growable", 256, growable_option) || growable2.Initialize(name + "Growable", 0))
+        return 111;
+
+    uint8_t growable_message[32] = { 0, };
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        memcpy(growable_message, &i, sizeof(i));
+        if (growable1.PushMessage(growable_message, sizeof(growable_message)))
+            return 112;
+    }
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        if (growable2.PopMessage(buffer, sizeof(buffer), &message_len) || sizeof(growable_message) != message_len ||
+            0 != memcmp(buffer, &i, sizeof(i)))
+            return 113;
+    }
+
+    // Consumer   Ƿ Producer  main ring  ư  segment   ȴ.
+    if (CQueueSharedMemory::POP_DATA_EMPTY != growable2.PopMessage(buffer, sizeof(buffer), &message_len) ||
+        growable1.PushMessage((const uint8_t*)str_send.c_str(), (uint32_t)str_send.size()) ||
+        growable2.PopMessage(buffer, sizeof(buffer), &message_len) || str_send != std::string((const char*)buffer, message_len))
+        return 114;
+
+    CSharedMemory removed_segment;
+    if (removed_segment.Open(name + "Growable.1") || removed_segment.Open(name + "Growable.3"))
+        return 115;
+
+    // max_segments     Ŀ NOT_ENOUGH_FREE_SPACE  return Ѵ.
+    uint32_t growable_count = 0;
+    int growable_ret = 0;
+    while (0 == (growable_ret = growable1.PushMessage(growable_message, sizeof(growable_message))))
+        growable_count++;
+
+    uint32_t growable_popped = 0;
+    while (0 == growable2.PopMessage(buffer, sizeof(buffer), &message_len))
+        growable_popped++;
+
+    if (CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE != growable_ret || growable_count < 20 || growable_count != growable_popped)
+        return 116;
+
+    // overwrite_oldest : Producer      ʰ,  Consumer   ִ   Message  д´.
+    CQueueSharedMemory::InitOption overwrite_option;
+    overwrite_option.overwrite_oldest = true;
+    CQueueSharedMemory overwrite1;
+    CQueueSharedMemory overwrite2;
+    if (overwrite1.Initialize(name + "Overwrite", 256, overwrite_option) || overwrite2.Initialize(name + "Overwrite", 0) ||
+        CQueueSharedMemory::NOT_SUPPORTED_MODE != overwrite1.Push((uint8_t*)str_send.c_str(), (uint32_t)str_send.size()))
+        return 117;
+
+    // Consumer     ϴ tail     ѹ ̻  Ѵ.
+    uint64_t overwrite_value = 0;
+    for (overwrite_value = 0; overwrite_value < 10; overwrite_value++)
+    {
+        if (overwrite1.PushMessage((const uint8_t*)&overwrite_value, sizeof(overwrite_value)))
+            return 118;
+    }
+
+    if (overwrite2.PopMessage(buffer, sizeof(buffer), &message_len))
+        return 118;
+
+    for (overwrite_value = 10; overwrite_value < 110; overwrite_value++)
+    {
+        if (overwrite1.PushMessage((const uint8_t*)&overwrite_value, sizeof(overwrite_value)))
+            return 119;
+    }
+
+    if (overwrite2.GetUseSize() > overwrite2.GetQueueSize() ||
+        CQueueSharedMemory::CONSUMER_LAGGED != overwrite2.PopMessage(buffer, sizeof(buffer), &message_len))
+        return 120;
+
+    //  ʰ  Message  ̾, ǳʶ Message  GetLostCount()  .
+    //  Message   POP_DATA_EMPTY  ޾ƾ Ѵ.
+    uint64_t overwrite_first = 0;
+    uint64_t overwrite_expected = 0;
+    int overwrite_ret = 0;
+    while (0 == (overwrite_ret = overwrite2.PopMessage(buffer, sizeof(buffer), &message_len)))
+    {
+        memcpy(&overwrite_value, buffer, sizeof(overwrite_value));
+        if (0 == overwrite_expected)
+            overwrite_first = overwrite_expected = overwrite_value;
+        if (overwrite_value != overwrite_expected++ || overwrite_expected > 110)
+            return 121;
+    }
+
+    if (CQueueSharedMemory::POP_DATA_EMPTY != overwrite_ret || overwrite_first <= 10 || 110 != overwrite_expected ||
+        overwrite_first - 1 != overwrite2.GetLostCount())
+        return 122;
+
+    // snapshot :   ٸ ʰ д     , version  ٸ copy  ʴ´.
+    CQueueSharedMemory::InitOption snapshot_option;
+    snapshot_option.snapshot_size = 4000;
+    CQueueSharedMemory snapshot1;
+    CQueueSharedMemory snapshot2;
+    if (snapshot1.Initialize(name + "Snapshot", 256, snapshot_option) || snapshot2.Initialize(name + "Snapshot", 0))
+        return 123;
+
+    std::vector<uint8_t> snapshot_buffer(4000);
+    uint32_t snapshot_len = 0;
+    uint64_t snapshot_version = 0;
+    if (CQueueSharedMemory::SNAPSHOT_DISABLED != queue1.WriteSnapshot(snapshot_buffer.data(), 8) ||
+        CQueueSharedMemory::RANGE_IS_NOT_RIGHT != snapshot1.WriteSnapshot(snapshot_buffer.data(), 4001) ||
+        CQueueSharedMemory::POP_DATA_EMPTY != snapshot2.ReadSnapshot(snapshot_buffer.data(), 4000, &snapshot_len, &snapshot_version))
+        return 124;
+
+    std::atomic<bool> snapshot_done(false);
+    std::thread snapshot_writer([&]()
+    {
+        std::vector<uint8_t> write_buffer(4000);
+        for (uint32_t i = 1; i <= 20000; i++)
+        {
+            // ̿   i   Ƿ ̸   ִ.
+            uint32_t length = 1000 + i % 3000;
+            memset(write_buffer.data(), (uint8_t)i, length);
+            snapshot1.WriteSnapshot(write_buffer.data(), length);
+        }
+        snapshot_done = true;
+    });
+
+    bool snapshot_torn = false;
+    while (false == snapshot_done && false == snapshot_torn)
+    {
+        if (snapshot2.ReadSnapshot(snapshot_buffer.data(), 4000, &snapshot_len, &snapshot_version))
+            continue;
+
+        uint8_t value = (uint8_t)snapshot_version;
+        snapshot_torn = (1000 + snapshot_version % 3000 != snapshot_len);
+        for (uint32_t i = 0; i < snapshot_len && false == snapshot_torn; i++)
+            snapshot_torn = (value != snapshot_buffer[i]);
+    }
+    snapshot_writer.join();
+
+    //  version   Ŀ  .
+    int snapshot_ret = snapshot2.ReadSnapshot(snapshot_buffer.data(), 4000, &snapshot_len, &snapshot_version);
+    if (snapshot_torn || 20000 != snapshot1.GetSnapshotVersion() || 20000 != snapshot_version ||
+        (0 != snapshot_ret && CQueueSharedMemory::SNAPSHOT_NOT_CHANGED != snapshot_ret) ||
+        CQueueSharedMemory::SNAPSHOT_NOT_CHANGED != snapshot2.ReadSnapshot(snapshot_buffer.data(), 4000, &snapshot_len, &snapshot_version))
+        return 125;
+
+    // RPC :  ٸ ʰ  û  Server  ٸ   ص û ȣ  .
+    CSharedRpcChannel rpc_client;
+    CSharedRpcChannel rpc_server;
+    if (rpc_client.Initialize(name + "Rpc", 4096, CSharedRpcChannel::RPC_ROLE_CLIENT) ||
+        rpc_server.Initialize(name + "Rpc", 4096, CSharedRpcChannel::RPC_ROLE_SERVER) ||
+        CQueueSharedMemory::NOT_SUPPORTED_MODE != rpc_server.Call(0, nullptr, 0, [](uint32_t, const uint8_t*, uint32_t) {}))
+        return 126;
+
+    uint32_t rpc_replied = 0;
+    bool rpc_mismatch = false;
+    uint64_t rpc_cancel_id = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        auto on_reply = [&, i](uint32_t status, const uint8_t* reply, uint32_t reply_len)
+        {
+            uint32_t value = 0;
+            memcpy(&value, reply, sizeof(value));
+            rpc_mismatch = rpc_mismatch || i + 100 != status || sizeof(value) != reply_len || i * 2 != value;
+            rpc_replied++;
+        };
+
+        if (rpc_client.Call(i, (const uint8_t*)&i, sizeof(i), on_reply, &rpc_cancel_id))
+            return 127;
+    }
+
+    //  û  Ͽ  .
+    if (rpc_client.Cancel(rpc_cancel_id) || 7 != rpc_client.GetPendingCount() ||
+        CQueueSharedMemory::RANGE_IS_NOT_RIGHT != rpc_client.Cancel(rpc_cancel_id))
+        return 128;
+
+    // Server   û  Ųٷ  Ѵ.
+    std::vector<std::pair<uint64_t, uint32_t>> rpc_requests;
+    uint32_t rpc_count = 0;
+    auto on_request = [&](uint64_t correlation_id, uint32_t, const uint8_t* request, uint32_t)
+    {
+        uint32_t value = 0;
+        memcpy(&value, request, sizeof(value));
+        rpc_requests.emplace_back(correlation_id, value);
+    };
+    if (rpc_server.PollRequests(UINT32_MAX, on_request, &rpc_count) || 8 != rpc_count)
+        return 129;
+
+    for (auto it = rpc_requests.rbegin(); it != rpc_requests.rend(); ++it)
+    {
+        uint32_t value = it->second * 2;
+        if (rpc_server.Reply(it->first, it->second + 100, (const uint8_t*)&value, sizeof(value)))
+            return 130;
+    }
+
+    if (rpc_client.PollReplies(UINT32_MAX, &rpc_count) || 8 != rpc_count || 7 != rpc_replied || rpc_mismatch || rpc_client.GetPendingCount())
+        return 131;
+
+    // ٸ thread  Server  ִ 16  û ÿ  ְ ޴´.
+    std::thread rpc_thread([&]()
+    {
+        uint32_t handled = 0;
+        auto echo = [&](uint64_t correlation_id, uint32_t method, const uint8_t* request, uint32_t request_len)
+        {
+            rpc_server.Reply(correlation_id, method, request, request_len);
+        };
+
+        for (uint32_t total = 0; total < 1000; total += handled)
+        {
+            if (rpc_server.WaitRequests(1000, echo, &handled))
+                break;
+        }
+    });
+
+    uint32_t rpc_sent = 0;
+    rpc_replied = 0;
+    while (rpc_replied < 1000 && false == rpc_mismatch)
+    {
+        while (rpc_sent < 1000 && rpc_client.GetPendingCount() < 16)
+        {
+            uint32_t value = rpc_sent;
+            auto on_reply = [&, value](uint32_t status, const uint8_t* reply, uint32_t reply_len)
+            {
+                uint32_t echoed = 0;
+                memcpy(&echoed, reply, sizeof(echoed));
+                rpc_mismatch = rpc_mismatch || value != status || sizeof(echoed) != reply_len || value != echoed;
+                rpc_replied++;
+            };
+
+            if (rpc_client.Call(value, (const uint8_t*)&value, sizeof(value), on_reply))
+                break;
+            rpc_sent++;
+        }
+
+        if (rpc_client.WaitReplies(1000, &rpc_count))
+            break;
+    }
+    rpc_thread.join();
+
+    if (1000 != rpc_replied || rpc_mismatch)
+        return 132;
+
+    // prefault / lock_memory :    page  ̸ Ҵ ϰ  Ѵ.  ϴ ʵ   Ѵ.
+    CQueueSharedMemory::InitOption placement_option;
+    placement_option.mirror = true;
+    placement_option.prefault = true;
+    placement_option.lock_memory = true;
+    {
+        CQueueSharedMemory placement1;
+        CQueueSharedMemory placement2;
+        if (placement1.Initialize("TestPlacementQueue", 4096, placement_option) || placement2.Initialize("TestPlacementQueue", 0, placement_option))
+            return 133;
+
+        if (placement1.PushMessage((const uint8_t*)"prefault", 8) || placement2.PopMessage(buffer, sizeof(buffer), &message_len) ||
+            "prefault" != std::string((const char*)buffer, message_len))
+            return 134;
+    }
+
+    // numa_node : node 0  ׻  (mbind    ʴ ȯ   Ѵ.)  node   ϰ ̸  ʴ´.
+    CQueueSharedMemory::InitOption numa_option;
+    numa_option.numa_node = 0;
+    {
+        CQueueSharedMemory numa_queue;
+        int numa_ret = numa_queue.Initialize("TestNumaQueue", 4096, numa_option);
+        if (0 != numa_ret && CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE != numa_ret)
+            return 135;
+
+        numa_option.numa_node = 4095;
+        CQueueSharedMemory invalid_numa_queue;
+        if (CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE != invalid_numa_queue.Initialize("TestInvalidNumaQueue", 4096, numa_option) ||
+            CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE != invalid_numa_queue.Initialize("TestInvalidNumaQueue", 0))
+            return 136;
+    }
+
+    //  thread  ÿ  ̸  /  ص ʱȭ  QueueInfo   ʴ´.
+    CQueueSharedMemory::InitOption ready_option;
+    ready_option.mirror = true;
+    for (uint32_t round = 0; round < 20; round++)
+    {
+        CQueueSharedMemory ready_queues[4];
+        std::atomic<uint32_t> ready_failed(0);
+        std::vector<std::thread> ready_threads;
+        for (CQueueSharedMemory& ready_queue : ready_queues)
+        {
+            ready_threads.emplace_back([&]()
+            {
+                if (ready_queue.Initialize("TestReadyQueue", 4096, ready_option))
+                    ready_failed++;
+            });
+        }
+        for (std::thread& ready_thread : ready_threads)
+            ready_thread.join();
+
+        if (ready_failed || ready_queues[1].PushMessage((const uint8_t*)"ready", 5) ||
+            ready_queues[2].PopMessage(buffer, sizeof(buffer), &message_len) || 5 != message_len)
+            return 137;
+    }
+
+    // CSharedCopy :  ϴ  kernel  ũ / Ŀ   memcpy        ʴ´.
+    std::vector<uint8_t> copy_source(70000);
+    for (size_t i = 0; i < copy_source.size(); i++)
+        copy_source[i] = (uint8_t)(i * 131 + 7);
+
+    size_t default_threshold = CSharedCopy::GetStreamThreshold();
+    CSharedCopy::CopyKernel default_kernel = CSharedCopy::GetKernel();
+    CSharedCopy::SetStreamThreshold(0);
+
+    const CSharedCopy::CopyKernel copy_kernels[] = {
+        CSharedCopy::COPY_KERNEL_MEMCPY, CSharedCopy::COPY_KERNEL_SSE2, CSharedCopy::COPY_KERNEL_AVX2, CSharedCopy::COPY_KERNEL_AVX512 };
+    const size_t copy_sizes[] = { 0, 1, 3, 7, 8, 15, 16, 31, 32, 33, 63, 64, 65, 255, 256, 257, 4095, 65537 };
+    bool copy_mismatch = false;
+    for (CSharedCopy::CopyKernel kernel : copy_kernels)
+    {
+        if (false == CSharedCopy::SetKernel(kernel))
+            continue;
+
+        for (size_t copy_size : copy_sizes)
+        {
+            for (size_t offset : { 0, 1, 17 })
+            {
+                std::vector<uint8_t> copy_destination(copy_size + 128, 0xCC);
+                CSharedCopy::ToShared(&copy_destination[offset], &copy_source[offset], copy_size);
+                copy_mismatch = copy_mismatch || 0 != memcmp(&copy_destination[offset], &copy_source[offset], copy_size) ||
+                    0xCC != copy_destination[offset + copy_size] || (offset && 0xCC != copy_destination[offset - 1]);
+
+                CSharedCopy::FromShared(&copy_destination[0], &copy_source[offset], copy_size);
+                copy_mismatch = copy_mismatch || 0 != memcmp(&copy_destination[0], &copy_source[offset], copy_size);
+            }
+        }
+    }
+    CSharedCopy::SetKernel(default_kernel);
+
+    if (copy_mismatch)
+    {
+        CSharedCopy::SetStreamThreshold(default_threshold);
+        return 138;
+    }
+
+    // non-temporal store  Push  ū Message  Consumer  ״ д´.
+    CSharedCopy::SetStreamThreshold(4096);
+    {
+        CQueueSharedMemory stream_queue;
+        std::vector<uint8_t> stream_buffer(copy_source.size());
+        uint32_t stream_len = 0;
+        bool stream_failed = stream_queue.Initialize("TestStreamCopyQueue", 256 * 1024) != 0;
+        for (uint32_t i = 0; i < 8 && false == stream_failed; i++)
+        {
+            stream_failed = stream_queue.PushMessage(copy_source.data() + i, (uint32_t)copy_source.size() - i) ||
+                stream_queue.PopMessage(stream_buffer.data(), (uint32_t)stream_buffer.size(), &stream_len) ||
+                copy_source.size() - i != stream_len || 0 != memcmp(stream_buffer.data(), copy_source.data() + i, stream_len);
+        }
+
+        CSharedCopy::SetStreamThreshold(default_threshold);
+        if (stream_failed)
+            return 139;
+    }
 
     return 0;
 }
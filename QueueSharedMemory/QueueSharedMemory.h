@@ -10,7 +10,12 @@
 ///  @class   CQueueSharedMemory
 ///  @brief   μ  Ҽ ִ  Queue   Ѵ.
 ///            Queue  ޸𸮿 Read / Write  Ͽ μ    ִ.
+///           head / tail   ٸ Cache line  atomic 64bit ̸
+///           ϳ Producer  ϳ Consumer ̿ lock     ִ.
+///           QueueMode    Producer / Consumer (MPMC)  ϳ Producer    (BROADCAST) ε    ִ.
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -30,21 +35,150 @@ public:
         READ_BUFFER_SIZE_IS_BIG,        // Read ϰ ϴ buffer  Queue   Use size  ŭ
         POP_DATA_EMPTY,                 // Pop  Ͱ 
         RANGE_IS_NOT_RIGHT,             //   
+        READ_BUFFER_SIZE_IS_SMALL,      // Read ϰ ϴ buffer  Message  
+        DID_NOT_RESERVE,                // Reserve()   ʾ
+        TIMEOUT_EXPIRED,                //  ð 
+        NOT_SUPPORTED_MODE,             //  QueueMode   ʴ Լ
+        DID_NOT_SUBSCRIBE,              // Subscribe()   ʾ
+        NOT_ENOUGH_CONSUMER_SLOT,       //    ִ Consumer   Ѿ
+        CONSUMER_LAGGED,                // Producer    Message   .  ֽ ġ  ٽ д´.
+                                        // (overwrite_oldest       Message  ٽ д´.)
+        READ_ONLY_QUEUE,                // InitializeReadOnly()   Queue   Ϸ 
+        STATISTICS_DISABLED,            // Queue  ÿ statistics   ʾ
+        SYNC_FAILED,                    // Ͽ  ϴµ   GetWinErrorCode()   code  Ȯ   ִ.
+        NOT_ENOUGH_LANE,                // CShardedSharedQueue :  Lane  ٸ Producer   
+        SNAPSHOT_DISABLED,              // Queue  ÿ snapshot_size   ʾ
+        SNAPSHOT_NOT_CHANGED,           // ReadSnapshot()  ѱ version    ʾ
     };
 
+    static const uint32_t WAIT_FOREVER = 0xFFFFFFFF;
+
+    enum QueueMode
+    {
+        QUEUE_MODE_SPSC = 0,            // Producer ϳ, Consumer ϳ. Byte  / Message    
+        QUEUE_MODE_MPMC,                // Producer , Consumer .  ũ Slot  Message θ  
+                                        // Producer  tail  CAS  ϰ Slot  ִ sequence  ϷḦ ˸.
+        QUEUE_MODE_BROADCAST,           // Producer ϳ, Subscribe()  Consumer . Message θ  
+                                        // Consumer  ڽ б ġ    Message  д´.
+    };
+
+    // InitOption::persistent  Ͽ  (msync / FlushViewOfFile) ϴ 
+    enum SyncPolicy
+    {
+        SYNC_NEVER = 0,                 //    ʴ´. OS   ϸ μ  Ǿ   ÿ   ִ.
+        SYNC_EVERY_MESSAGES,            // sync_threshold  Message   Ѵ.
+        SYNC_EVERY_BYTES,               // sync_threshold Byte     Ѵ.
+        SYNC_INTERVAL,                  // sync_threshold ms    Push / Pop   Ѵ.
+    };
+
+    // Queue  ó    Ǵ . ̹  Queue        .
+    // (persistent, sync_policy, sync_threshold, numa_node, prefault, lock_memory   ϴ ü   Ѵ.)
+    struct InitOption
+    {
+        bool        mirror;     //    ޸𸮿 ι  mapping Ѵ.
+                                // Queue   Ѿ ͵ ӵ ּҰ Ǿ wrap ó ʿ .
+                                // queue_size  Allocation granularity (Linux : page, Windows : 64KB)   ø ȴ.
+        QueueMode   mode;       // Shared Memory  ϵǸ ϴ ʵ  mode   Ѵ.
+        uint32_t    slot_size;  // QUEUE_MODE_MPMC : Message  ִ  (Byte)
+        uint32_t    max_consumers;      // QUEUE_MODE_BROADCAST : ÿ Subscribe()   ִ Consumer  
+        bool        overrun_laggards;   // QUEUE_MODE_BROADCAST : false ̸   Consumer  ٸ,
+                                        // true ̸ ٸ ʰ    Consumer  CONSUMER_LAGGED  ޴´.
+        bool        huge_pages; // Huge page (Linux : hugetlbfs, Windows : SEC_LARGE_PAGES)   õ Ѵ.
+                                //    ٸ Ϲ page   ϸ IsHugePages()  Ȯ   ִ. mirror  Բ    .
+        bool        statistics; // Shared Memory    ΰ Push / Pop   Ѵ. GetStatistics()    ִ.
+        bool        persistent; // name   η  Ͽ  mapping Ѵ.  ϴ  ü  ؾ Ѵ.
+                                // ٽ  ϸ Ͽ  ִ head / tail  ̾  Ѵ. huge_pages   ȴ.
+        SyncPolicy  sync_policy;        // persistent : Ͽ  ϴ 
+        uint64_t    sync_threshold;     // persistent : sync_policy  Message , Byte ũ Ǵ ms
+        uint32_t    max_segments;       // QUEUE_MODE_SPSC : 0  ƴϸ  á    ʰ  ũ overflow segment
+                                        // (name.1, name.2 ...)  ִ max_segments     Ѵ.
+                                        // Consumer    а   segment   ȴ.
+                                        // PushMessage() / PushWait() / PopMessage() / PopWait()  segment   ϸ
+                                        //   Լ GetUseSize()  main ring  ٷ. persistent  Բ    .
+        bool        overwrite_oldest;   // QUEUE_MODE_SPSC :    ϰų ٸ ʰ   Message   .
+                                        // Producer  Consumer  ġ  ,  Consumer  CONSUMER_LAGGED   
+                                        //  ִ   Message  д´.    GetLostCount()  Ȯ Ѵ.
+                                        // Message θ     max_segments  Բ    .
+        uint32_t    snapshot_size;      // 0  ƴϸ Queue   ũ (Byte)  snapshot  д.
+                                        // ֽ  ϳ WriteSnapshot()    ReadSnapshot()  д´.
+        int         numa_node;          // 0 ̻ ̸ Shared Memory   NUMA node  ޸𸮿 Ҵ Ѵ.
+                                        // Linux      mbind  ű, Windows     ȣ node   Ѵ.
+        bool        prefault;           //     page  ̸ Ҵ Ͽ ù Push / Pop  page fault   ʰ Ѵ.
+        bool        lock_memory;        //    mapping   ޸𸮿  (mlock / VirtualLock) Ͽ swap  ʰ Ѵ.
+                                        // numa_node, prefault, lock_memory   ϸ Initialize()  CREATE_MAMORY_MAP_HANDLE 
+                                        // return ϸ GetWinErrorCode()   Ȯ   ִ.
+
+        InitOption()
+            : mirror(false)
+            , mode(QUEUE_MODE_SPSC)
+            , slot_size(0)
+            , max_consumers(8)
+            , overrun_laggards(false)
+            , huge_pages(false)
+            , statistics(false)
+            , persistent(false)
+            , sync_policy(SYNC_NEVER)
+            , sync_threshold(0)
+            , max_segments(0)
+            , overwrite_oldest(false)
+            , snapshot_size(0)
+            , numa_node(-1)
+            , prefault(false)
+            , lock_memory(false)
+        {
+        }
+    };
+
+    // GetStatistics()  д Queue    
+    // QUEUE_MODE_BROADCAST  pop   Consumer  ̴.
+    struct Statistics
+    {
+        uint64_t    push_count;         // ߰ Message   (Push()  ȣ Ƚ)
+        uint64_t    push_bytes;         // ߰  Byte ũ (Message header )
+        uint64_t    push_full_count;    // NOT_ENOUGH_FREE_SPACE   Ƚ (PushWait()    õ )
+        uint64_t    push_wait_count;    // PushWait()    ٸ  Ƚ
+        uint64_t    pop_count;          // ŵ Message   (Pop()  ȣ Ƚ)
+        uint64_t    pop_bytes;          // ŵ  Byte ũ
+        uint64_t    pop_wait_count;     // PopWait() / PopBatchWait()  Message  ٸ  Ƚ
+        uint64_t    high_water_size;    // Producer  Push Ŀ    Byte ũ ִ 
+    };
+
+    // PushBatch() / PushMessage()  ϴ  ϳ ּҿ  (iovec   )
+    struct MessageBuffer
+    {
+        const uint8_t*  buffer;
+        uint32_t        buffer_len;
+    };
+
+    // PopBatch()  Message  ȣ ȴ. buffer  Shared Memory  ּҷ callback ȿ ȿ ϴ.
+    typedef std::function<void(const uint8_t* buffer, uint32_t buffer_len)> MessageCallback;
+
     CQueueSharedMemory();
     virtual ~CQueueSharedMemory();
 
     ///  @brief      Shared Memory   ü Ҵϰ ʱȭ Ų.
     ///              MSDN : CreateFileMapping, OpenFileMapping, MapViewOfFile API 
+    ///              Linux  shm_open, ftruncate, mmap API  Ѵ.
     ///  @param name[in] : Shared Memory  ̸ Ͽ ̸ Key  ܺο  Ѵ.
     ///                    name  Global namespace    Ѵٸ   ʿ ϴ.
     ///                    ڼ  MSDN  
-    ///  @param queue_size[in] : Byte  Queue size  
+    ///  @param queue_size[in] : Byte  Queue size   (Message   8   ø ȴ.)
+    ///                          4GB ̻  ϸ Message ϳ ̴ 32bit  ̴.
     ///                          ش Name  ̹ Shared Memory  ִٸ queue_size   ǰ
     ///                              Ѵ.
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
-    int  Initialize(const std::string& name, uint32_t queue_size);
+    int  Initialize(const std::string& name, uint64_t queue_size);
+
+    ///  @brief      InitOption  Ͽ Shared Memory Queue  ʱȭ Ѵ.
+    ///  @param option[in] : Queue        
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int  Initialize(const std::string& name, uint64_t queue_size, const InitOption& option);
+
+    ///  @brief      ̹  Queue  б   Ѵ. ¸  ϴ 뵵 Queue  ϴ Լ READ_ONLY_QUEUE  return Ѵ.
+    ///              Queue      Ƿ ٸ ü  Finalize() ϸ ̸    ִ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int  InitializeReadOnly(const std::string& name);
 
     ///  @brief      Shared Memory    ü  Ѵ.
     void Finalize();
@@ -54,15 +188,33 @@ public:
     std::string GetName() const;
 
     ///  @brief      Shared Memory   32Ʈ ũ  ͸ ´.
+    ///              SetInformation()  ÿ ȣ Ǹ Ⱑ   ٽ Ƿ    ʴ´.
     ///  @param buffer[out] : 32 Ʈ Ҵ buffer   ͸ copy Ͽ ȯѴ.
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
     int GetInformation(uint8_t* buffer);
 
     ///  @brief      Shared Memory   32Ʈ ũ  ͸  Ѵ.
+    ///              ÿ   ϳ  Ѵ.
     ///  @param buffer[in] : buffer  ͸ 32Ʈ ŭ Shared Memory  copy Ѵ.
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
     int SetInformation(uint8_t* buffer);
 
+    ///  @brief      snapshot  buffer    version   Ų. д  ٸ ʴ´.
+    ///              ÿ   ϳ  Ѵ.
+    ///  @return      ÿ 0, snapshot   ũٸ RANGE_IS_NOT_RIGHT,
+    ///              snapshot  ٸ SNAPSHOT_DISABLED  return Ѵ.
+    int WriteSnapshot(const uint8_t* buffer, uint32_t buffer_len);
+
+    ///  @brief      snapshot  buffer  copy Ѵ. д ߿ WriteSnapshot()  ־ٸ ٽ д´.
+    ///  @param snapshot_len[out] : snapshot  Byte ũ. buffer  ۴ٸ ʿ ũⰡ  ȴ.
+    ///  @param version[in/out] :   version (ó 0).  snapshot  version   ȴ.
+    ///  @return      ÿ 0, version   ٸ copy  ʰ SNAPSHOT_NOT_CHANGED,
+    ///              ѹ  ʾҴٸ POP_DATA_EMPTY,  ÿ FailedCode  return Ѵ.
+    int ReadSnapshot(uint8_t* buffer, uint32_t buffer_len, uint32_t* snapshot_len, uint64_t* version);
+
+    ///  @brief      snapshot  version  return Ѵ. WriteSnapshot()  1   ϸ snapshot  ٸ 0 ̴.
+    uint64_t GetSnapshotVersion() const;
+
     ///  @brief      Shared Memory  Queue  .
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
     int Clear();
@@ -84,33 +236,163 @@ public:
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
     int Pop();
 
+    ///  @brief      Shared Memory  Queue  ϳ Message  ߰ Ѵ.
+    ///              Message  8 Byte ĵ  header  Բ Ǹ Queue     ʴ´.
+    ///              Push() / Front() / Pop()   Queue    ϸ ȵȴ.
+    ///  @param buffer[in] : buffer  ͸ buffer_len  ŭ Queue  copy Ѵ.
+    ///  @param buffer_len[in] : Message   (Byte)
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int PushMessage(const uint8_t* buffer, uint32_t buffer_len);
+
+    ///  @brief      Shared Memory  Queue    Message ϳ  Queue   Ѵ.
+    ///  @param buffer[out] : Message  copy  buffer
+    ///  @param buffer_len[in] : buffer   (Byte)
+    ///  @param message_len[out] : Message   (Byte), READ_BUFFER_SIZE_IS_SMALL    ȴ.
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len);
+
+    ///  @brief        ͸ ̾ ٿ ϳ Message  ߰ Ѵ.
+    ///  @param fragments[in] : Message  ϴ   迭
+    ///  @param fragment_count[in] : fragments  
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int PushMessage(const MessageBuffer* fragments, uint32_t fragment_count);
+
+    ///  @brief       Message   ߰ Ѵ.  copy   tail  ѹ  Ѵ.
+    ///              (QUEUE_MODE_MPMC  ӵ Slot  ѹ CAS   Ѵ.)
+    ///                ϸ  ŭ ߰ Ѵ.
+    ///  @param messages[in] : ߰  Message  迭
+    ///  @param count[in] : messages  
+    ///  @param pushed_count[out] : ߰ Message  
+    ///  @return      ߰ ϸ 0, Ϻθ ߰ ߴٸ NOT_ENOUGH_FREE_SPACE  FailedCode  return Ѵ.
+    int PushBatch(const MessageBuffer* messages, uint32_t count, uint32_t* pushed_count);
+
+    ///  @brief      ִ max_count  Message  copy  callback  ѱ  head  ѹ  Ѵ.
+    ///  @param max_count[in] :  Message  ִ 
+    ///  @param callback[in] : Message  ȣ  Լ
+    ///  @param popped_count[out] :  Message  
+    ///  @return      ÿ 0, Message  ٸ POP_DATA_EMPTY,  ÿ FailedCode  return Ѵ.
+    ///              QUEUE_MODE_BROADCAST  CONSUMER_LAGGED   callback      ִ.
+    int PopBatch(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count);
+
+    ///  @brief      Shared Memory  Queue ȿ Message    ϰ  ּҸ return Ѵ.
+    ///              buffer   ͸   Commit()  ȣؾ Consumer   ȴ.
+    ///  @param buffer_len[in] : Message   (Byte)
+    ///  @param buffer[out] : Shared Memory    ּ, Commit()  ȿ ϴ.
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int Reserve(uint32_t buffer_len, uint8_t** buffer);
+
+    ///  @brief      Reserve()   Message  Consumer   Ѵ.
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int Commit();
+
+    ///  @brief      Shared Memory  Queue    Message  copy  Shared Memory  ּҷ ´.
+    ///                Release()  ȣؾ Queue   ȴ.
+    ///  @param buffer[out] : Message  б  ּ, Release()  ȿ ϴ.
+    ///  @param buffer_len[out] : Message   (Byte)
+    ///  @return      ÿ 0, Message  ٸ POP_DATA_EMPTY  return Ѵ.
+    int Peek(const uint8_t** buffer, uint32_t* buffer_len);
+
+    ///  @brief      Peek()   Message  Queue   Ѵ.
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int Release();
+
+    ///  @brief      PushMessage()     ٸ     Ѵ.
+    ///               spin / yield  ٸ  Linux  futex, Windows  Event  .
+    ///              Consumer   ִ Producer      system call  Ѵ.
+    ///  @param buffer[in] : buffer  ͸ buffer_len  ŭ Queue  copy Ѵ.
+    ///  @param buffer_len[in] : Message   (Byte)
+    ///  @param timeout_ms[in] : ִ  ð (ms), WAIT_FOREVER ̸  
+    ///  @return      ÿ 0,  ð  TIMEOUT_EXPIRED,  ÿ FailedCode  return Ѵ.
+    int PushWait(const uint8_t* buffer, uint32_t buffer_len, uint32_t timeout_ms);
+
+    ///  @brief      PopMessage()   Message  ٸ     Ѵ.
+    ///              Producer   ִ Consumer      system call  Ѵ.
+    ///  @param buffer[out] : Message  copy  buffer
+    ///  @param buffer_len[in] : buffer   (Byte)
+    ///  @param message_len[out] : Message   (Byte)
+    ///  @param timeout_ms[in] : ִ  ð (ms), WAIT_FOREVER ̸  
+    ///  @return      ÿ 0,  ð  TIMEOUT_EXPIRED,  ÿ FailedCode  return Ѵ.
+    int PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms);
+
+    ///  @brief      PopBatch()   Message  ٸ     Ѵ.  PopWait()  .
+    ///  @param timeout_ms[in] : ִ  ð (ms), WAIT_FOREVER ̸  
+    ///  @return      ÿ 0,  ð  TIMEOUT_EXPIRED,  ÿ FailedCode  return Ѵ.
+    int PopBatchWait(uint32_t max_count, const MessageCallback& callback, uint32_t* popped_count, uint32_t timeout_ms);
+
+    ///  @brief      QUEUE_MODE_BROADCAST  Consumer   Ѵ.  Ŀ Push  Message  д´.
+    ///              Consumer    ü  ȣ ؾ ϸ Finalize() ÿ ڵ  ȴ.
+    ///              Producer  ϵ Consumer    Consumer        Ƿ
+    ///               ʴ Consumer  Unsubscribe() ؾ Ѵ. (overrun_laggards   ϸ ٸ ʴ´.)
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int Subscribe();
+
+    ///  @brief      Subscribe()   Consumer   Ѵ.
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int Unsubscribe();
+
+    ///  @brief      epoll / poll (Windows  WaitForMultipleObjects)     ִ ˸ handle  .
+    ///              Linux  /dev/shm Ʒ Queue ̸  FIFO  fd, Windows  ̸ ִ Event  HANDLE ̸
+    ///              Finalize() ÿ . (FIFO    ̸ Queue  ٽ  Ѵ.)
+    ///              ArmNotify() Ŀ ó Push  Message  ѹ ˸Ƿ ˸  Queue      
+    ///              ٽ ArmNotify()  ȣ Ѵ. QUEUE_MODE_BROADCAST     .
+    ///  @param handle[out] : fd Ǵ HANDLE
+    ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
+    int OpenNotifyHandle(intptr_t* handle);
+
+    ///  @brief      ˸ handle   ˸   Push  ˸  Ѵ. ̹ Message  ִٸ ٷ ˸.
+    ///  @return      ÿ 0, OpenNotifyHandle()    ʾҴٸ DID_NOT_INITIALIZE  return Ѵ.
+    int ArmNotify();
+
+    ///  @brief      Shared Memory  Queue    Message ̸ ´.
+    ///  @param message_len[out] : Message   (Byte)
+    ///  @return      ÿ 0, Message  ٸ POP_DATA_EMPTY  return Ѵ.
+    int PeekMessageSize(uint32_t* message_len);
+
     ///  @brief      Shared Memory Queue  Ư ġ ͸ copy Ѵ.
     ///  @param pos[in] : Queue  ġ
     ///  @param buffer[in] : buffer  ͸ buffer_len  ŭ Queue  copy Ѵ.
     ///  @param buffer_len[in] : buffer    (Byte)
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
-    int SetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len);
+    int SetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len);
 
     ///  @brief      Shared Memory Queue  Ư ġ ͸ buffer  copy Ѵ.
     ///  @param pos[in] : Queue  ġ
     ///  @param buffer[out] : buffer  ͸ buffer_len  ŭ Queue  copy Ѵ.
     ///  @param buffer_len[in] : buffer    (Byte)
     ///  @return      ÿ 0,  ÿ FailedCode  return Ѵ.
-    int GetData(uint32_t pos, uint8_t* buffer, uint32_t buffer_len);
+    int GetData(uint64_t pos, uint8_t* buffer, uint32_t buffer_len);
 
     ///  @brief      Shared Memory Queue    Byte ũ⸦ return Ѵ.
     ///  @return      ÿ Queue   Byte ũ,  ÿ 0  return Ѵ.
-    uint32_t GetUseSize() const;
+    uint64_t GetUseSize() const;
 
     ///  @brief      Shared Memory Queue   ũ⸦ return Ѵ.
     ///  @return      ÿ Queue  Byte ũ,  ÿ 0  return Ѵ.
-    uint32_t GetQueueSize() const;
+    uint64_t GetQueueSize() const;
 
     ///  @brief      Shared Memory Queue    Byte  ũ return Ѵ.
     ///  @return      ÿ Queue   Byte ũ,  ÿ 0  return Ѵ.
-    uint32_t GetFreeSize() const;
+    uint64_t GetFreeSize() const;
+
+    ///  @brief      overwrite_oldest   ü Consumer  д      Message   return Ѵ.
+    ///              Message  ִ ȣ  ó Message     .
+    uint64_t GetLostCount() const;
+
+    ///  @brief      Shared Memory  Huge page  mapping Ǿ ִٸ true  return Ѵ.
+    bool IsHugePages() const;
+
+    ///  @brief      InitOption::persistent   ߴٸ    Push  Ϳ head / tail  Ͽ  Ѵ.
+    ///              sync_policy    ȣ     ƴ϶ ƹ͵  ʴ´.
+    ///  @return      ÿ 0,  ÿ SYNC_FAILED  FailedCode  return Ѵ.
+    int Sync();
+
+    ///  @brief      Shared Memory    д´.    Ƿ  ణ ߳  ִ.
+    ///  @param statistics[out] :   
+    ///  @return      ÿ 0,   ٸ STATISTICS_DISABLED,  ÿ FailedCode  return Ѵ.
+    int GetStatistics(Statistics* statistics) const;
 
     ///  @brief      Windows API ȣ   ÿ GetLastError()  ڵ  return Ѵ.
+    ///              Linux   API  errno  return Ѵ.
     ///  @return     GetLastError() ڵ尪 return Ѵ.
     uint32_t GetWinErrorCode() const;
 };
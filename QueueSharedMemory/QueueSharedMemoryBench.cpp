@@ -0,0 +1,930 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef _WINDOWS_
+#include <windows.h>
+#endif
+#include <intrin.h>
+#else
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "QueueSharedMemory.h"
+#include "ShardedSharedQueue.h"
+#include "SharedCopy.h"
+#include "SharedRpcChannel.h"
+
+//   α׷
+// mpmc excute : QueueSharedMemoryBench mpmc [max_producers] [messages_per_producer]
+// sharded excute : QueueSharedMemoryBench sharded [max_producers] [messages_per_producer]
+// batch excute : QueueSharedMemoryBench batch [messages] [message_size]
+// process excute : QueueSharedMemoryBench process [messages] [producer_cpu] [consumer_cpu] [csv|json] [rate]
+// rpc excute : QueueSharedMemoryBench rpc [calls] [client_cpu] [server_cpu]
+// copy excute : QueueSharedMemoryBench copy [total_mb] [hot_kb]
+
+//////////////////////////////////////////////////////////////////////////
+
+// 밡  ߴ Ȯ ϱ  ⸦  ð (ms)
+static const uint32_t BENCH_WAIT_MS = 100;
+
+static double ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// μ    ִ ð (Linux : CLOCK_MONOTONIC, Windows : QueryPerformanceCounter)
+static uint64_t NowNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//  thread  cpu ȣ core   ǵ Ѵ. cpu     ʴ´.
+static bool PinCurrentThread(int cpu)
+{
+    if (cpu < 0)
+        return true;
+
+#ifdef _WIN32
+    return 0 != SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+#else
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    return 0 == sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CLatencyHistogram
+///  @brief   HDR Histogram   2  ŵ   SUB_BUCKET_COUNT / 2  bucket  ξ
+///                 ( 1.6%)   Ѵ.
+class CLatencyHistogram
+{
+private:
+    static const uint32_t SUB_BUCKET_BITS  = 7;
+    static const uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const uint32_t SUB_BUCKET_HALF  = SUB_BUCKET_COUNT / 2;
+
+    std::vector<uint64_t>   m_counts;
+    uint64_t                m_total;
+    uint64_t                m_max;
+
+    static uint32_t HighestBit(uint64_t value)
+    {
+#ifdef _WIN32
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    // value < SUB_BUCKET_COUNT  ״,  ̻  SUB_BUCKET_BITS bit   index  .
+    static uint32_t ToIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT)
+            return (uint32_t)value;
+
+        uint32_t shift = HighestBit(value) - (SUB_BUCKET_BITS - 1);
+        return shift * SUB_BUCKET_HALF + (uint32_t)(value >> shift);
+    }
+
+    // index  ϵ    ū 
+    static uint64_t ToValue(uint32_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+            return index;
+
+        uint32_t shift = index / SUB_BUCKET_HALF - 1;
+        uint64_t sub_bucket = index - shift * SUB_BUCKET_HALF;
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+public:
+    CLatencyHistogram()
+        : m_counts(64 * SUB_BUCKET_HALF, 0)
+        , m_total(0)
+        , m_max(0)
+    {
+
+    }
+
+    void Record(uint64_t value)
+    {
+        m_counts[ToIndex(value)]++;
+        m_total++;
+        m_max = std::max(m_max, value);
+    }
+
+    ///  @brief      percentile (0 ~ 100) ġ  return Ѵ.
+    uint64_t GetPercentile(double percentile) const
+    {
+        if (0 == m_total)
+            return 0;
+
+        uint64_t target = (uint64_t)(percentile / 100.0 * m_total + 0.5);
+        target = std::max<uint64_t>(1, std::min(target, m_total));
+
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < m_counts.size(); i++)
+        {
+            count += m_counts[i];
+            if (count >= target)
+                return std::min(ToValue(i), m_max);
+        }
+
+        return m_max;
+    }
+
+    uint64_t GetMax() const
+    {
+        return m_max;
+    }
+};
+
+// QUEUE_MODE_MPMC  Producer  1  max_producers  ø ó  Ѵ.
+static int BenchMpmc(int argc, char* argv[])
+{
+    uint32_t max_producers = (argc > 2) ? (uint32_t)atoi(argv[2]) : std::thread::hardware_concurrency();
+    uint64_t message_count = (argc > 3) ? (uint64_t)atoll(argv[3]) : 1000000;
+    if (0 == max_producers)
+        max_producers = 1;
+
+    const std::string name = "QueueSharedMemoryBenchMpmc";
+
+    CQueueSharedMemory::InitOption option;
+    option.mode = CQueueSharedMemory::QUEUE_MODE_MPMC;
+    option.slot_size = 64;
+
+    printf("producers,messages,seconds,msgs_per_sec\n");
+
+    for (uint32_t producers = 1; producers <= max_producers; producers++)
+    {
+        CQueueSharedMemory queue;
+        int ret = queue.Initialize(name, 1024 * 1024, option);
+        if (ret)
+        {
+            printf("queue initialize failed   code[%d]\n", ret);
+            return 1;
+        }
+
+        uint64_t total = message_count * producers;
+        std::atomic<bool> start_flag(false);
+        std::atomic<int> producer_error(0);     //  Producer  ִٸ Consumer  ٸ ʵ code  .
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < producers; i++)
+        {
+            threads.emplace_back([&]()
+            {
+                CQueueSharedMemory producer;
+                int producer_ret = producer.Initialize(name, 0);
+                if (producer_ret)
+                {
+                    producer_error.store(producer_ret);
+                    return;
+                }
+
+                uint8_t message[64] = { 0, };
+                while (!start_flag.load())
+                    std::this_thread::yield();
+
+                for (uint64_t n = 0; n < message_count; n++)
+                {
+                    // Consumer  ٸ   Queue   ٸ ʴ´.
+                    while (CQueueSharedMemory::TIMEOUT_EXPIRED == (producer_ret = producer.PushWait(message, sizeof(message), BENCH_WAIT_MS)))
+                    {
+                        if (producer_error.load())
+                            return;
+                    }
+
+                    if (producer_ret)
+                    {
+                        producer_error.store(producer_ret);
+                        return;
+                    }
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        start_flag.store(true);
+
+        uint8_t message[64];
+        uint32_t message_len = 0;
+        uint64_t popped = 0;
+        while (popped < total && 0 == producer_error.load())
+        {
+            if (0 == queue.PopWait(message, sizeof(message), &message_len, BENCH_WAIT_MS))
+                popped++;
+        }
+
+        double seconds = ElapsedSeconds(start);
+        for (auto& thread : threads)
+            thread.join();
+
+        if (producer_error.load())
+        {
+            printf("producer failed   code[%d]\n", producer_error.load());
+            return 1;
+        }
+
+        printf("%u,%llu,%.6f,%.0f\n", producers, (unsigned long long)total, seconds, total / seconds);
+    }
+
+    return 0;
+}
+
+// CShardedSharedQueue  Producer  1  max_producers  ø ó  Ѵ.
+// Producer   ٸ core   Ǿ  Lane  Ƿ mpmc     ִ.
+static int BenchSharded(int argc, char* argv[])
+{
+    uint32_t max_producers = (argc > 2) ? (uint32_t)atoi(argv[2]) : std::thread::hardware_concurrency();
+    uint64_t message_count = (argc > 3) ? (uint64_t)atoll(argv[3]) : 1000000;
+    if (0 == max_producers)
+        max_producers = 1;
+
+    const std::string name = "QueueSharedMemoryBenchSharded";
+    const uint32_t cpu_count = std::max(1u, std::thread::hardware_concurrency());
+
+    printf("producers,messages,seconds,msgs_per_sec\n");
+
+    for (uint32_t producers = 1; producers <= max_producers; producers++)
+    {
+        CShardedSharedQueue queue;
+        int ret = queue.Initialize(name, producers, 1024 * 1024 / producers);
+        if (ret)
+        {
+            printf("queue initialize failed   code[%d]\n", ret);
+            return 1;
+        }
+
+        uint64_t total = message_count * producers;
+        std::atomic<bool> start_flag(false);
+        std::atomic<int> producer_error(0);     //  Producer  ִٸ Consumer  ٸ ʵ code  .
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < producers; i++)
+        {
+            threads.emplace_back([&, i]()
+            {
+                PinCurrentThread((int)(i % cpu_count));
+
+                CShardedSharedQueue producer;
+                int producer_ret = producer.Initialize(name, producers, 1024 * 1024 / producers);
+                if (0 == producer_ret)
+                    producer_ret = producer.AcquireLane();
+                if (producer_ret)
+                {
+                    producer_error.store(producer_ret);
+                    return;
+                }
+
+                uint8_t message[64] = { 0, };
+                while (!start_flag.load())
+                    std::this_thread::yield();
+
+                for (uint64_t n = 0; n < message_count; n++)
+                {
+                    while (producer.PushMessage(message, sizeof(message)))
+                    {
+                        // Consumer  ٸ   Lane   ٸ ʴ´.
+                        if (producer_error.load())
+                            return;
+
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        start_flag.store(true);
+
+        uint64_t popped = 0;
+        uint32_t popped_count = 0;
+        while (popped < total && 0 == producer_error.load())
+        {
+            if (0 == queue.PopBatch(256, [](const uint8_t*, uint32_t) {}, &popped_count))
+                popped += popped_count;
+            else
+                std::this_thread::yield();
+        }
+
+        double seconds = ElapsedSeconds(start);
+        for (auto& thread : threads)
+            thread.join();
+
+        if (producer_error.load())
+        {
+            printf("producer initialize failed   code[%d]\n", producer_error.load());
+            return 1;
+        }
+
+        printf("%u,%llu,%.6f,%.0f\n", producers, (unsigned long long)total, seconds, total / seconds);
+    }
+
+    return 0;
+}
+
+// SPSC  PushBatch() / PopBatch()  batch ũ⿡  ó  Ѵ. batch 1  Message   ϴ Ͱ .
+static int BenchBatch(int argc, char* argv[])
+{
+    uint64_t message_count = (argc > 2) ? (uint64_t)atoll(argv[2]) : 10000000;
+    uint32_t message_size = (argc > 3) ? (uint32_t)atoi(argv[3]) : 32;
+    if (0 == message_size)
+        message_size = 1;
+
+    const std::string name = "QueueSharedMemoryBenchBatch";
+    const uint32_t batch_sizes[] = { 1, 8, 64, 512 };
+
+    printf("batch,message_size,messages,seconds,msgs_per_sec\n");
+
+    for (uint32_t batch_size : batch_sizes)
+    {
+        CQueueSharedMemory queue;
+        int ret = queue.Initialize(name, 1024 * 1024);
+        if (ret)
+        {
+            printf("queue initialize failed   code[%d]\n", ret);
+            return 1;
+        }
+
+        std::vector<uint8_t> message(message_size, 0);
+        std::vector<CQueueSharedMemory::MessageBuffer> batch(batch_size);
+        for (auto& buffer : batch)
+        {
+            buffer.buffer = message.data();
+            buffer.buffer_len = message_size;
+        }
+
+        std::atomic<bool> start_flag(false);
+        std::atomic<int> producer_error(0);     // Producer   ߴٸ Consumer  ٸ ʵ code  .
+        std::thread producer([&]()
+        {
+            CQueueSharedMemory push_queue;
+            int producer_ret = push_queue.Initialize(name, 0);
+            if (producer_ret)
+            {
+                producer_error.store(producer_ret);
+                return;
+            }
+
+            while (!start_flag.load())
+                std::this_thread::yield();
+
+            uint64_t sent = 0;
+            while (sent < message_count)
+            {
+                uint32_t count = (uint32_t)std::min<uint64_t>(batch_size, message_count - sent);
+                uint32_t pushed_count = 0;
+                push_queue.PushBatch(batch.data(), count, &pushed_count);
+                if (0 == pushed_count)
+                    std::this_thread::yield();
+
+                sent += pushed_count;
+            }
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        start_flag.store(true);
+
+        uint64_t received = 0;
+        uint64_t received_bytes = 0;
+        auto callback = [&](const uint8_t*, uint32_t buffer_len) { received_bytes += buffer_len; };
+        while (received < message_count && 0 == producer_error.load())
+        {
+            uint32_t popped_count = 0;
+            queue.PopBatch(batch_size, callback, &popped_count);
+            if (0 == popped_count)
+                std::this_thread::yield();
+
+            received += popped_count;
+        }
+
+        double seconds = ElapsedSeconds(start);
+        producer.join();
+
+        if (producer_error.load())
+        {
+            printf("producer initialize failed   code[%d]\n", producer_error.load());
+            return 1;
+        }
+
+        if (received_bytes != message_count * message_size)
+        {
+            printf("received size mismatch   batch[%u]\n", batch_size);
+            return 1;
+        }
+
+        printf("%u,%u,%llu,%.6f,%.0f\n", batch_size, message_size, (unsigned long long)message_count, seconds, message_count / seconds);
+    }
+
+    return 0;
+}
+
+// Producer μ. Message   8 Byte   ð  Ͽ Consumer   ð    ְ Ѵ.
+// rate  0  ƴ϶ ʴ rate  ӵ    ̾ ð  ϹǷ
+// Queue    ʰ  ð  ð  ȴ.
+static int RunProcessProducer(const std::string& name, uint32_t message_size, uint64_t message_count, uint32_t batch_size, uint64_t rate, int cpu)
+{
+    PinCurrentThread(cpu);
+
+    CQueueSharedMemory queue;
+    if (queue.Initialize(name, 0))
+        return 1;
+
+    std::vector<uint8_t> messages((size_t)message_size * batch_size, 0);
+    std::vector<CQueueSharedMemory::MessageBuffer> batch(batch_size);
+    for (uint32_t i = 0; i < batch_size; i++)
+    {
+        batch[i].buffer = messages.data() + (size_t)message_size * i;
+        batch[i].buffer_len = message_size;
+    }
+
+    uint64_t start = NowNanoseconds();
+    uint64_t sent = 0;
+    while (sent < message_count)
+    {
+        uint32_t count = (uint32_t)std::min<uint64_t>(batch_size, message_count - sent);
+        uint64_t now = NowNanoseconds();
+        if (rate)
+        {
+            uint64_t scheduled = start + (uint64_t)((double)sent * 1e9 / rate);
+            if (now < scheduled)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            now = scheduled;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+            memcpy(messages.data() + (size_t)message_size * i, &now, sizeof(now));
+
+        uint32_t pushed_count = 0;
+        queue.PushBatch(batch.data(), count, &pushed_count);
+        if (0 == pushed_count)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        sent += pushed_count;
+    }
+
+    return 0;
+}
+
+// Producer μ  Ѵ. Linux  fork, Windows  ڽ process-producer  ٽ  Ѵ.
+static bool StartProducerProcess(const std::string& name, uint32_t message_size, uint64_t message_count, uint32_t batch_size, uint64_t rate,
+                                 int cpu, void** process)
+{
+#ifdef _WIN32
+    char path[MAX_PATH] = { 0, };
+    if (0 == GetModuleFileNameA(nullptr, path, MAX_PATH))
+        return false;
+
+    char command_line[MAX_PATH + 256] = { 0, };
+    snprintf(command_line, sizeof(command_line), "\"%s\" process-producer %s %u %llu %u %llu %d",
+        path, name.c_str(), message_size, (unsigned long long)message_count, batch_size, (unsigned long long)rate, cpu);
+
+    STARTUPINFOA startup_info = { sizeof(startup_info), };
+    PROCESS_INFORMATION process_info = { 0, };
+    if (FALSE == CreateProcessA(nullptr, command_line, nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup_info, &process_info))
+        return false;
+
+    CloseHandle(process_info.hThread);
+    *process = process_info.hProcess;
+    return true;
+#else
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+
+    // ڽ θ ü   ʵ _exit   Ѵ.
+    if (0 == pid)
+        _exit(RunProcessProducer(name, message_size, message_count, batch_size, rate, cpu));
+
+    *process = reinterpret_cast<void*>((intptr_t)pid);
+    return true;
+#endif
+}
+
+// Producer μ Ḧ Ȯ Ѵ. wait  false  ٸ    ̶ *exited  false  ȴ.
+//  ߴٸ process   ϰ  θ return Ѵ.   ̶ true  return Ѵ.
+static bool WaitProducerProcess(void* process, bool wait, bool* exited)
+{
+#ifdef _WIN32
+    *exited = (WAIT_OBJECT_0 == WaitForSingleObject(process, wait ? INFINITE : 0));
+    if (false == *exited)
+        return true;
+
+    DWORD exit_code = 1;
+    GetExitCodeProcess(process, &exit_code);
+    CloseHandle(process);
+    return 0 == exit_code;
+#else
+    int status = 0;
+    pid_t ret = waitpid((pid_t)reinterpret_cast<intptr_t>(process), &status, wait ? 0 : WNOHANG);
+    *exited = (0 != ret);
+    if (false == *exited)
+        return true;
+    if (ret < 0)
+        return false;
+
+    return WIFEXITED(status) && 0 == WEXITSTATUS(status);
+#endif
+}
+
+// Producer μ queue_size  Queue  message_count      ð histogram   Ѵ.
+//  ÿ   ϰ 1  return Ѵ.
+static int RunProcessPass(const std::string& name, uint64_t queue_size, uint32_t message_size, uint64_t message_count, uint32_t batch_size,
+                          uint64_t rate, int producer_cpu, double* seconds, CLatencyHistogram* histogram)
+{
+    CQueueSharedMemory queue;
+    int ret = queue.Initialize(name, queue_size);
+    if (ret)
+    {
+        printf("queue initialize failed   code[%d]\n", ret);
+        return 1;
+    }
+
+    void* process = nullptr;
+    if (false == StartProducerProcess(name, message_size, message_count, batch_size, rate, producer_cpu, &process))
+    {
+        printf("producer process start failed\n");
+        return 1;
+    }
+
+    uint64_t received = 0;
+    uint64_t first_sent = 0;
+    auto callback = [&](const uint8_t* buffer, uint32_t)
+    {
+        uint64_t sent = 0;
+        memcpy(&sent, buffer, sizeof(sent));
+        uint64_t now = NowNanoseconds();
+        histogram->Record(now > sent ? now - sent : 0);
+
+        if (0 == received++)
+            first_sent = sent;
+    };
+
+    // Queue     Producer μ  ߴ Ȯ Ͽ  ߰ų
+    //    Message   оµ  ϴٸ  ٸ ʴ´.
+    bool exited = false;
+    bool succeeded = true;
+    while (received < message_count && succeeded)
+    {
+        uint32_t popped_count = 0;
+        queue.PopBatch(batch_size, callback, &popped_count);
+        if (popped_count)
+            continue;
+        if (exited)
+            break;
+
+        succeeded = WaitProducerProcess(process, false, &exited);
+        if (false == exited)
+            std::this_thread::yield();
+    }
+
+    // μ  ð Ե ʵ ù Message   ð  Ѵ.
+    *seconds = (NowNanoseconds() - first_sent) / 1e9;
+    if (false == exited)
+        succeeded = WaitProducerProcess(process, true, &exited);
+
+    if (false == succeeded || received < message_count)
+    {
+        printf("producer process failed   received[%llu/%llu]\n", (unsigned long long)received, (unsigned long long)message_count);
+        return 1;
+    }
+
+    return 0;
+}
+
+struct ProcessBenchResult
+{
+    uint32_t    message_size;
+    uint64_t    queue_size;
+    uint32_t    batch_size;
+    uint64_t    message_count;
+    double      seconds;
+    uint64_t    latency_rate;
+    uint64_t    p50;
+    uint64_t    p99;
+    uint64_t    p999;
+    uint64_t    max;
+};
+
+//  Producer μ Consumer ( μ)  ó  ð
+// Message ũ, Queue ũ, batch ũ   Ͽ csv Ǵ json   Ѵ.
+// ó ִ    ϰ,  Message  ٸ ð  ʵ  ð
+// ʴ rate  ӵ message_count / 10     Ѵ. rate  0 ̶ ó   Ѵ.
+static int BenchProcess(int argc, char* argv[])
+{
+    uint64_t message_count = (argc > 2) ? (uint64_t)atoll(argv[2]) : 200000;
+    int producer_cpu = (argc > 3) ? atoi(argv[3]) : -1;
+    int consumer_cpu = (argc > 4) ? atoi(argv[4]) : -1;
+    bool json = (argc > 5) && 0 == strcmp(argv[5], "json");
+    uint64_t rate = (argc > 6) ? (uint64_t)atoll(argv[6]) : 100000;
+    if (0 == message_count)
+        message_count = 1;
+
+    const std::string name = "QueueSharedMemoryBenchProcess";
+    const uint32_t message_sizes[] = { 16, 64, 256, 1024, 4096 };
+    const uint64_t queue_sizes[] = { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+    const uint32_t batch_sizes[] = { 1, 8, 64 };
+    const uint64_t latency_count = std::max<uint64_t>(message_count / 10, 1);
+
+    PinCurrentThread(consumer_cpu);
+
+    std::vector<ProcessBenchResult> results;
+    for (uint32_t message_size : message_sizes)
+    {
+        for (uint64_t queue_size : queue_sizes)
+        {
+            for (uint32_t batch_size : batch_sizes)
+            {
+                double seconds = 0;
+                CLatencyHistogram unpaced;
+                if (RunProcessPass(name, queue_size, message_size, message_count, batch_size, 0, producer_cpu, &seconds, &unpaced))
+                    return 1;
+
+                double paced_seconds = 0;
+                CLatencyHistogram paced;
+                if (rate && RunProcessPass(name, queue_size, message_size, latency_count, batch_size, rate, producer_cpu, &paced_seconds, &paced))
+                    return 1;
+
+                const CLatencyHistogram& histogram = rate ? paced : unpaced;
+
+                ProcessBenchResult result;
+                result.message_size = message_size;
+                result.queue_size = queue_size;
+                result.batch_size = batch_size;
+                result.message_count = message_count;
+                result.seconds = seconds;
+                result.latency_rate = rate;
+                result.p50 = histogram.GetPercentile(50.0);
+                result.p99 = histogram.GetPercentile(99.0);
+                result.p999 = histogram.GetPercentile(99.9);
+                result.max = histogram.GetMax();
+                results.push_back(result);
+            }
+        }
+    }
+
+    if (false == json)
+        printf("message_size,queue_size,batch,messages,seconds,msgs_per_sec,gb_per_sec,latency_rate,p50_ns,p99_ns,p999_ns,max_ns\n");
+    else
+        printf("[\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const ProcessBenchResult& result = results[i];
+        double msgs_per_sec = result.message_count / result.seconds;
+        double gb_per_sec = msgs_per_sec * result.message_size / 1e9;
+
+        if (false == json)
+        {
+            printf("%u,%llu,%u,%llu,%.6f,%.0f,%.3f,%llu,%llu,%llu,%llu,%llu\n",
+                result.message_size, (unsigned long long)result.queue_size, result.batch_size, (unsigned long long)result.message_count,
+                result.seconds, msgs_per_sec, gb_per_sec, (unsigned long long)result.latency_rate,
+                (unsigned long long)result.p50, (unsigned long long)result.p99, (unsigned long long)result.p999, (unsigned long long)result.max);
+        }
+        else
+        {
+            printf("  {\"message_size\": %u, \"queue_size\": %llu, \"batch\": %u, \"messages\": %llu, \"seconds\": %.6f, "
+                "\"msgs_per_sec\": %.0f, \"gb_per_sec\": %.3f, \"latency_rate\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}%s\n",
+                result.message_size, (unsigned long long)result.queue_size, result.batch_size, (unsigned long long)result.message_count,
+                result.seconds, msgs_per_sec, gb_per_sec, (unsigned long long)result.latency_rate,
+                (unsigned long long)result.p50, (unsigned long long)result.p99, (unsigned long long)result.p999, (unsigned long long)result.max,
+                (i + 1 < results.size()) ? "," : "");
+        }
+    }
+
+    if (json)
+        printf("]\n");
+
+    return 0;
+}
+
+// CSharedRpcChannel  ÿ  û  (depth)   պ ð ó  Ѵ. Server  ٸ thread  echo Ѵ.
+static int BenchRpc(int argc, char* argv[])
+{
+    uint64_t call_count = (argc > 2) ? (uint64_t)atoll(argv[2]) : 200000;
+    int client_cpu = (argc > 3) ? atoi(argv[3]) : -1;
+    int server_cpu = (argc > 4) ? atoi(argv[4]) : -1;
+    if (0 == call_count)
+        call_count = 1;
+
+    const std::string name = "QueueSharedMemoryBenchRpc";
+    const uint32_t depths[] = { 1, 8, 64 };
+
+    PinCurrentThread(client_cpu);
+    printf("depth,calls,seconds,calls_per_sec,p50_ns,p99_ns,p999_ns,max_ns\n");
+
+    for (uint32_t depth : depths)
+    {
+        CSharedRpcChannel client;
+        int ret = client.Initialize(name, 1024 * 1024, CSharedRpcChannel::RPC_ROLE_CLIENT);
+        if (ret)
+        {
+            printf("channel initialize failed   code[%d]\n", ret);
+            return 1;
+        }
+
+        std::atomic<bool> stop_flag(false);
+        std::atomic<int> server_error(0);       // Server   ߴٸ Client   ٸ ʵ code  .
+        std::thread server_thread([&]()
+        {
+            PinCurrentThread(server_cpu);
+
+            CSharedRpcChannel server;
+            int server_ret = server.Initialize(name, 1024 * 1024, CSharedRpcChannel::RPC_ROLE_SERVER);
+            if (server_ret)
+            {
+                server_error.store(server_ret);
+                return;
+            }
+
+            auto echo = [&](uint64_t correlation_id, uint32_t method, const uint8_t* buffer, uint32_t buffer_len)
+            {
+                while (server.Reply(correlation_id, method, buffer, buffer_len))
+                    std::this_thread::yield();
+            };
+
+            uint32_t handled = 0;
+            while (!stop_flag.load(std::memory_order_relaxed))
+            {
+                if (server.PollRequests(256, echo, &handled))
+                    std::this_thread::yield();
+            }
+        });
+
+        // û  ð ְ   ð ̸  Ѵ.
+        CLatencyHistogram histogram;
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        auto on_reply = [&](uint32_t, const uint8_t* buffer, uint32_t)
+        {
+            uint64_t sent_time = 0;
+            memcpy(&sent_time, buffer, sizeof(sent_time));
+            uint64_t now = NowNanoseconds();
+            histogram.Record(now > sent_time ? now - sent_time : 0);
+            received++;
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        while (received < call_count && 0 == server_error.load())
+        {
+            while (sent < call_count && sent - received < depth)
+            {
+                uint64_t now = NowNanoseconds();
+                if (client.Call(0, (const uint8_t*)&now, sizeof(now), on_reply))
+                    break;
+                sent++;
+            }
+
+            uint32_t completed = 0;
+            if (client.PollReplies(depth, &completed))
+                std::this_thread::yield();
+        }
+
+        double seconds = ElapsedSeconds(start);
+        stop_flag.store(true);
+        server_thread.join();
+
+        if (server_error.load())
+        {
+            printf("server initialize failed   code[%d]\n", server_error.load());
+            return 1;
+        }
+
+        printf("%u,%llu,%.6f,%.0f,%llu,%llu,%llu,%llu\n", depth, (unsigned long long)call_count, seconds, call_count / seconds,
+            (unsigned long long)histogram.GetPercentile(50.0), (unsigned long long)histogram.GetPercentile(99.0),
+            (unsigned long long)histogram.GetPercentile(99.9), (unsigned long long)histogram.GetMax());
+    }
+
+    return 0;
+}
+
+// Message ũ  memcpy  non-temporal store (CSharedCopy)  Push  ó,
+// Push ̿ Producer    ϴ hot_kb ũ ͸ ٽ д ð (Cache  о  )   Ѵ.
+static int BenchCopy(int argc, char* argv[])
+{
+    uint64_t total_bytes = ((argc > 2) ? (uint64_t)atoll(argv[2]) : 2048) * 1024 * 1024;
+    size_t hot_size = ((argc > 3) ? (size_t)atoll(argv[3]) : 512) * 1024;
+
+    const std::string name = "QueueSharedMemoryBenchCopy";
+    const uint32_t message_sizes[] = { 4 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024 };
+    const char* kernel_names[] = { "memcpy", "sse2", "avx2", "avx512" };
+    const CSharedCopy::CopyKernel detected_kernel = CSharedCopy::DetectKernel();
+    const size_t default_threshold = CSharedCopy::GetStreamThreshold();
+
+    std::vector<uint8_t> hot(hot_size, 1);
+    uint64_t hot_sum = 0;
+
+    printf("kernel,message_size,messages,push_gb_per_sec,hot_scan_ns\n");
+
+    for (uint32_t message_size : message_sizes)
+    {
+        uint64_t message_count = std::max<uint64_t>(total_bytes / message_size, 16);
+        std::vector<uint8_t> message(message_size, 0x5A);
+
+        //  kernel  SIZE_MAX (memcpy)  0 ( ũ non-temporal)  threshold   Ѵ.
+        for (int stream = 0; stream < 2; stream++)
+        {
+            CSharedCopy::SetKernel(detected_kernel);
+            CSharedCopy::SetStreamThreshold(stream ? 0 : SIZE_MAX);
+
+            CQueueSharedMemory queue;
+            int ret = queue.Initialize(name, (uint64_t)message_size * 4 + 4096);
+            if (ret)
+            {
+                printf("queue initialize failed   code[%d]\n", ret);
+                CSharedCopy::SetStreamThreshold(default_threshold);
+                return 1;
+            }
+
+            double push_seconds = 0;
+            double hot_seconds = 0;
+            for (uint64_t i = 0; i < message_count; i++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                if (queue.PushMessage(message.data(), message_size))
+                {
+                    printf("push failed   size[%u]\n", message_size);
+                    CSharedCopy::SetStreamThreshold(default_threshold);
+                    return 1;
+                }
+                push_seconds += ElapsedSeconds(start);
+
+                // Consumer  copy  Ƿ   Cache  о  ʴ´.
+                uint32_t popped_count = 0;
+                queue.PopBatch(1, [](const uint8_t*, uint32_t) {}, &popped_count);
+
+                start = std::chrono::steady_clock::now();
+                for (size_t offset = 0; offset < hot_size; offset += 64)
+                    hot_sum += hot[offset];
+                hot_seconds += ElapsedSeconds(start);
+            }
+
+            printf("%s,%u,%llu,%.2f,%.0f\n", stream ? kernel_names[detected_kernel] : "memcpy", message_size, (unsigned long long)message_count,
+                (double)message_size * message_count / push_seconds / 1e9, hot_seconds * 1e9 / message_count);
+        }
+    }
+
+    CSharedCopy::SetStreamThreshold(default_threshold);
+
+    // hot  д loop  ȭ  ʵ  Ѵ.
+    return hot_sum ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("usage : QueueSharedMemoryBench mpmc [max_producers] [messages_per_producer]\n");
+        printf("        QueueSharedMemoryBench sharded [max_producers] [messages_per_producer]\n");
+        printf("        QueueSharedMemoryBench batch [messages] [message_size]\n");
+        printf("        QueueSharedMemoryBench process [messages] [producer_cpu] [consumer_cpu] [csv|json] [rate]\n");
+        printf("        QueueSharedMemoryBench rpc [calls] [client_cpu] [server_cpu]\n");
+        printf("        QueueSharedMemoryBench copy [total_mb] [hot_kb]\n");
+        return 0;
+    }
+
+    std::string mode = argv[1];
+    if ("mpmc" == mode)
+        return BenchMpmc(argc, argv);
+    if ("sharded" == mode)
+        return BenchSharded(argc, argv);
+    if ("batch" == mode)
+        return BenchBatch(argc, argv);
+    if ("process" == mode)
+        return BenchProcess(argc, argv);
+    if ("rpc" == mode)
+        return BenchRpc(argc, argv);
+    if ("copy" == mode)
+        return BenchCopy(argc, argv);
+
+    // Windows  BenchProcess()   ϴ Producer μ
+    if ("process-producer" == mode && argc > 7)
+        return RunProcessProducer(argv[2], (uint32_t)atoi(argv[3]), (uint64_t)atoll(argv[4]), (uint32_t)atoi(argv[5]), (uint64_t)atoll(argv[6]), atoi(argv[7]));
+
+    printf("unknown mode [%s]\n", mode.c_str());
+    return 1;
+}
@@ -0,0 +1,414 @@
+#include "ShardedSharedQueue.h"
+#include "SharedCopy.h"
+
+#include <atomic>
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef _WINDOWS_
+#include <windows.h>
+#endif
+#else
+#include <sched.h>
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    const uint32_t SHARD_INFO_MAGIC    = 0x51534D53;    // 'QSMS'
+    const uint32_t SHARD_INFO_VERSION  = 1;
+
+    const uint32_t SHARD_FLAG_SEQUENCE = 0x01;          // Message header  ü  ȣ 
+
+    const uint32_t LANE_ALIGN          = 64;            // Lane    Cache line  .
+
+    const uint32_t LANE_FREE           = 0;
+    const uint32_t LANE_OWNED          = 1;
+}
+
+// Shared Memory   տ ġ ϸ  ڿ LaneInfo[lane_count], Lane    ʷ ٴ´.
+struct CShardedSharedQueue::ShardInfo
+{
+    //  ÿ ѹ  Ǵ 
+    alignas(64) std::atomic<uint32_t>   magic;
+    uint32_t                version;
+    uint32_t                flags;
+    uint32_t                lane_count;
+    uint64_t                lane_size;
+    uint64_t                buffer_offset;  // ShardInfo   ù Lane     Byte ũ
+
+    // SHARD_FLAG_SEQUENCE :  Producer   Ű  ȣ
+    alignas(64) std::atomic<uint32_t>   sequence;
+
+    CSharedRing::Signal                 signal;
+};
+
+// Lane ϳ head / tail.   CSharedRing  а .
+struct CShardedSharedQueue::LaneInfo
+{
+    // Lane   Producer   Cache line
+    alignas(64) std::atomic<uint64_t>   tail;
+    std::atomic<uint32_t>               owner;      // LANE_FREE / LANE_OWNED
+
+    // Consumer   Cache line
+    alignas(64) std::atomic<uint64_t>   head;
+};
+
+CShardedSharedQueue::CShardedSharedQueue()
+    : m_shard_info(nullptr)
+    , m_lanes(nullptr)
+    , m_lane_buffer(nullptr)
+    , m_lane_count(0)
+    , m_lane_size(0)
+    , m_lane(nullptr)
+    , m_lane_data(nullptr)
+    , m_cached_head(0)
+    , m_next_lane(0)
+    , m_policy(SHARD_POLICY_ROUND_ROBIN)
+    , m_error_code(0)
+{
+
+}
+
+CShardedSharedQueue::~CShardedSharedQueue()
+{
+    Finalize();
+}
+
+bool CShardedSharedQueue::CreateSharedMemory(uint32_t lane_count, uint64_t lane_size, bool sequence)
+{
+    uint64_t buffer_offset = CSharedRing::AlignUp(sizeof(ShardInfo) + sizeof(LaneInfo) * (uint64_t)lane_count, LANE_ALIGN);
+    if (false == m_shared_memory.Create(m_name, buffer_offset + lane_size * lane_count))
+    {
+        m_error_code = m_shared_memory.GetErrorCode();
+        return false;
+    }
+
+    //    0  ä Ƿ  Lane   ְ LANE_FREE ̴.
+    ShardInfo* shard_info = reinterpret_cast<ShardInfo*>(m_shared_memory.GetAddress());
+    shard_info->flags = sequence ? SHARD_FLAG_SEQUENCE : 0;
+    shard_info->lane_count = lane_count;
+    shard_info->lane_size = lane_size;
+    shard_info->buffer_offset = buffer_offset;
+    shard_info->version = SHARD_INFO_VERSION;
+
+    shard_info->magic.store(SHARD_INFO_MAGIC, std::memory_order_release);
+
+    return true;
+}
+
+bool CShardedSharedQueue::GetSharedPoint()
+{
+    if (m_shared_memory.GetSize() < sizeof(ShardInfo))
+        return false;
+
+    ShardInfo* shard_info = reinterpret_cast<ShardInfo*>(m_shared_memory.GetAddress());
+    if (SHARD_INFO_MAGIC != shard_info->magic.load(std::memory_order_acquire) || SHARD_INFO_VERSION != shard_info->version)
+        return false;
+
+    uint64_t buffer_offset = CSharedRing::AlignUp(sizeof(ShardInfo) + sizeof(LaneInfo) * (uint64_t)shard_info->lane_count, LANE_ALIGN);
+    if (buffer_offset != shard_info->buffer_offset ||
+        m_shared_memory.GetSize() < buffer_offset + shard_info->lane_size * shard_info->lane_count)
+        return false;
+
+    m_shard_info = shard_info;
+    m_lanes = reinterpret_cast<LaneInfo*>(shard_info + 1);
+    m_lane_buffer = reinterpret_cast<uint8_t*>(shard_info) + buffer_offset;
+    m_lane_count = shard_info->lane_count;
+    m_lane_size = shard_info->lane_size;
+
+    return true;
+}
+
+int CShardedSharedQueue::Initialize(const std::string& name, uint32_t lane_count, uint64_t lane_size, bool sequence)
+{
+    Finalize();
+
+    if (0 == lane_count || lane_size < sizeof(MessageHeader))
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    m_name = name;
+    lane_size = CSharedRing::AlignUp(lane_size, LANE_ALIGN);
+
+    int ret = CSharedAttach::OpenOrCreate(m_shared_memory, m_name,
+        [&]() { return CreateSharedMemory(lane_count, lane_size, sequence); }, &m_error_code);
+    if (ret)
+    {
+        Finalize();
+        return ret;
+    }
+
+    if (false == GetSharedPoint() || lane_count != m_lane_count || lane_size != m_lane_size ||
+        sequence != (0 != (m_shard_info->flags & SHARD_FLAG_SEQUENCE)))
+    {
+        Finalize();
+        return CQueueSharedMemory::BRING_QUEUE_INFO;
+    }
+
+    if (false == m_data_event.Open(m_name + "_DataEvent", &m_shard_info->signal.data_event))
+    {
+        Finalize();
+        return CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE;
+    }
+
+    m_cached_tails.assign(m_lane_count, 0);
+    m_next_lane = 0;
+    m_policy = sequence ? SHARD_POLICY_SEQUENCE : SHARD_POLICY_ROUND_ROBIN;
+
+    return 0;
+}
+
+void CShardedSharedQueue::Finalize()
+{
+    ReleaseLane();
+
+    m_data_event.Close();
+    m_shared_memory.Close();
+    m_shard_info = nullptr;
+    m_lanes = nullptr;
+    m_lane_buffer = nullptr;
+    m_lane_count = 0;
+    m_lane_size = 0;
+    m_cached_tails.clear();
+}
+
+int CShardedSharedQueue::AcquireLane()
+{
+    if (nullptr == m_shard_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+    if (m_lane)
+        return 0;
+
+#ifdef _WIN32
+    uint32_t cpu = GetCurrentProcessorNumber();
+#else
+    int cpu_number = sched_getcpu();
+    uint32_t cpu = cpu_number < 0 ? 0 : (uint32_t)cpu_number;
+#endif
+
+    for (uint32_t i = 0; i < m_lane_count; i++)
+    {
+        LaneInfo* lane = &m_lanes[(cpu + i) % m_lane_count];
+        uint32_t expected = LANE_FREE;
+        if (lane->owner.compare_exchange_strong(expected, LANE_OWNED, std::memory_order_acquire))
+        {
+            m_lane = lane;
+            m_lane_data = m_lane_buffer + ((cpu + i) % m_lane_count) * m_lane_size;
+            m_cached_head = lane->head.load(std::memory_order_acquire);
+            return 0;
+        }
+    }
+
+    return CQueueSharedMemory::NOT_ENOUGH_LANE;
+}
+
+void CShardedSharedQueue::ReleaseLane()
+{
+    if (nullptr == m_lane)
+        return;
+
+    //  ϴ Producer  tail  ̾   ֵ release  ȯ Ѵ.
+    m_lane->owner.store(LANE_FREE, std::memory_order_release);
+    m_lane = nullptr;
+    m_lane_data = nullptr;
+}
+
+int CShardedSharedQueue::GetLane() const
+{
+    if (nullptr == m_lane)
+        return -1;
+
+    return (int)(m_lane - m_lanes);
+}
+
+int CShardedSharedQueue::PushMessage(const uint8_t* buffer, uint32_t buffer_len)
+{
+    if (nullptr == m_lane)
+    {
+        int ret = AcquireLane();
+        if (ret)
+            return ret;
+    }
+
+    // tail  Lane   Producer   ϹǷ relaxed  д´.
+    uint64_t tail = m_lane->tail.load(std::memory_order_relaxed);
+    uint64_t next_tail = 0;
+    MessageHeader* header = CSharedRing::Reserve(m_lane_data, m_lane_size, tail, m_lane->head, &m_cached_head, buffer_len, &next_tail);
+    if (nullptr == header)
+        return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE;
+
+    header->length = buffer_len;
+    header->sequence = (m_shard_info->flags & SHARD_FLAG_SEQUENCE) ?
+        m_shard_info->sequence.fetch_add(1, std::memory_order_relaxed) : 0;
+    CSharedCopy::ToShared(header + 1, buffer, buffer_len);
+
+    m_lane->tail.store(next_tail, std::memory_order_release);
+    CSharedRing::Notify(m_shard_info->signal, m_data_event);
+
+    return 0;
+}
+
+// lane  *head ġ ִ Message  return Ѵ. ٸ nullptr  return Ѵ.
+CShardedSharedQueue::MessageHeader* CShardedSharedQueue::FrontMessage(uint32_t lane, uint64_t* head)
+{
+    return CSharedRing::Front(m_lane_buffer + lane * m_lane_size, m_lane_size, m_lanes[lane].tail, &m_cached_tails[lane], head);
+}
+
+// m_policy     Lane  Message  .
+CShardedSharedQueue::MessageHeader* CShardedSharedQueue::SelectLane(uint32_t* lane, uint64_t* head)
+{
+    MessageHeader* selected = nullptr;
+    for (uint32_t i = 0; i < m_lane_count; i++)
+    {
+        uint32_t index = (m_next_lane + i) % m_lane_count;
+        uint64_t pos_head = m_lanes[index].head.load(std::memory_order_relaxed);
+        MessageHeader* header = FrontMessage(index, &pos_head);
+        if (nullptr == header)
+            continue;
+
+        //  ȣ 32bit  ȯ ϹǷ  ȣ  Ѵ.
+        if (nullptr == selected || (int32_t)(header->sequence - selected->sequence) < 0)
+        {
+            selected = header;
+            *lane = index;
+            *head = pos_head;
+        }
+
+        if (SHARD_POLICY_ROUND_ROBIN == m_policy)
+            break;
+    }
+
+    if (selected)
+        m_next_lane = (*lane + 1) % m_lane_count;
+
+    return selected;
+}
+
+int CShardedSharedQueue::PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len)
+{
+    if (nullptr == m_shard_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    uint32_t lane = 0;
+    uint64_t head = 0;
+    MessageHeader* header = SelectLane(&lane, &head);
+    if (nullptr == header)
+        return CQueueSharedMemory::POP_DATA_EMPTY;
+
+    uint32_t length = header->length;
+    *message_len = length;
+    if (buffer_len < length)
+        return CQueueSharedMemory::READ_BUFFER_SIZE_IS_SMALL;
+
+    CSharedCopy::FromShared(buffer, header + 1, length);
+    m_lanes[lane].head.store(head + CSharedRing::RecordSize(length), std::memory_order_release);
+
+    return 0;
+}
+
+int CShardedSharedQueue::PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms)
+{
+    if (nullptr == m_shard_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    return CSharedRing::PopWait(m_shard_info->signal, m_data_event, timeout_ms,
+        [&]() { return PopMessage(buffer, buffer_len, message_len); });
+}
+
+int CShardedSharedQueue::PopBatch(uint32_t max_count, const CQueueSharedMemory::MessageCallback& callback, uint32_t* popped_count)
+{
+    *popped_count = 0;
+    if (nullptr == m_shard_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    if (SHARD_POLICY_SEQUENCE == m_policy)
+    {
+        //  Ű Message  ٽ  Ѵ.
+        while (*popped_count < max_count)
+        {
+            uint32_t lane = 0;
+            uint64_t head = 0;
+            MessageHeader* header = SelectLane(&lane, &head);
+            if (nullptr == header)
+                break;
+
+            uint32_t length = header->length;
+            callback(reinterpret_cast<uint8_t*>(header + 1), length);
+            m_lanes[lane].head.store(head + CSharedRing::RecordSize(length), std::memory_order_release);
+            (*popped_count)++;
+        }
+    }
+    else
+    {
+        // Lane     callback  ѱ  head  ѹ  Ѵ.
+        uint32_t first_lane = m_next_lane;
+        for (uint32_t i = 0; i < m_lane_count && *popped_count < max_count; i++)
+        {
+            uint32_t lane = (first_lane + i) % m_lane_count;
+            uint64_t head = m_lanes[lane].head.load(std::memory_order_relaxed);
+            uint32_t lane_count = 0;
+            for (; *popped_count < max_count; (*popped_count)++, lane_count++)
+            {
+                MessageHeader* header = FrontMessage(lane, &head);
+                if (nullptr == header)
+                    break;
+
+                uint32_t length = header->length;
+                callback(reinterpret_cast<uint8_t*>(header + 1), length);
+                head += CSharedRing::RecordSize(length);
+            }
+
+            if (lane_count)
+            {
+                m_lanes[lane].head.store(head, std::memory_order_release);
+                m_next_lane = (lane + 1) % m_lane_count;
+            }
+        }
+    }
+
+    if (0 == *popped_count)
+        return CQueueSharedMemory::POP_DATA_EMPTY;
+
+    return 0;
+}
+
+int CShardedSharedQueue::SetPolicy(ShardPolicy policy)
+{
+    if (nullptr == m_shard_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+    if (SHARD_POLICY_SEQUENCE == policy && 0 == (m_shard_info->flags & SHARD_FLAG_SEQUENCE))
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+
+    m_policy = policy;
+
+    return 0;
+}
+
+uint64_t CShardedSharedQueue::GetUseSize() const
+{
+    if (nullptr == m_shard_info)
+        return 0;
+
+    uint64_t use_size = 0;
+    for (uint32_t i = 0; i < m_lane_count; i++)
+    {
+        // head   о tail  Ŀ ʴ´.
+        uint64_t head = m_lanes[i].head.load(std::memory_order_acquire);
+        uint64_t tail = m_lanes[i].tail.load(std::memory_order_acquire);
+        use_size += tail - head;
+    }
+
+    return use_size;
+}
+
+uint32_t CShardedSharedQueue::GetLaneCount() const
+{
+    return m_lane_count;
+}
+
+uint32_t CShardedSharedQueue::GetWinErrorCode() const
+{
+    return m_error_code;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    ShardedSharedQueue.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CShardedSharedQueue
+///  @brief   ϳ Shared Memory ȿ   SPSC Message Queue (Lane)  lane_count   Ѵ.
+///           Producer ü ó Push    CPU ȣ Lane   ( ̸  Lane) ϰ
+///            Lane  Ƿ Producer   Cache line  ΰ   ʴ´.
+///           Consumer  ϳ ̸ ShardPolicy    Lane  ư д´.
+///           Producer ü ϳ  thread   ؾ Ѵ.
+
+#include "QueueSharedMemory.h"
+#include "SharedAttach.h"
+#include "SharedEvent.h"
+#include "SharedMemory.h"
+#include "SharedRing.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CShardedSharedQueue
+{
+private:
+    struct ShardInfo;
+    struct LaneInfo;
+    typedef CSharedRing::MessageHeader MessageHeader;
+
+    std::string    m_name;
+
+    CSharedMemory  m_shared_memory;
+    CSharedEvent   m_data_event;
+    ShardInfo*     m_shard_info;
+    LaneInfo*      m_lanes;
+    uint8_t*       m_lane_buffer;
+    uint32_t       m_lane_count;
+    uint64_t       m_lane_size;
+
+    // Producer  
+    LaneInfo*      m_lane;              //  Lane, ٸ nullptr
+    uint8_t*       m_lane_data;
+    uint64_t       m_cached_head;
+
+    // Consumer  
+    std::vector<uint64_t>   m_cached_tails;
+    uint32_t       m_next_lane;
+    uint32_t       m_policy;
+
+    uint32_t       m_error_code;
+
+private:
+    bool CreateSharedMemory(uint32_t lane_count, uint64_t lane_size, bool sequence);
+    bool GetSharedPoint();
+    MessageHeader* FrontMessage(uint32_t lane, uint64_t* head);
+    MessageHeader* SelectLane(uint32_t* lane, uint64_t* head);
+
+public:
+    enum ShardPolicy
+    {
+        SHARD_POLICY_ROUND_ROBIN = 0,   // Message ϳ   Lane  Ѿ  Producer  ϰ д´.
+        SHARD_POLICY_SEQUENCE,          //  Message  ü  ȣ    д´. sequence   ؾ Ѵ.
+    };
+
+    CShardedSharedQueue();
+    ~CShardedSharedQueue();
+
+    CShardedSharedQueue(const CShardedSharedQueue&) = delete;
+    CShardedSharedQueue& operator=(const CShardedSharedQueue&) = delete;
+
+    ///  @brief      ̸ Queue   ϰų ̹ ִ Queue   Ѵ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @param lane_count[in] : Lane  ,  Producer    CPU   ̴.
+    ///  @param lane_size[in] : Lane ϳ   Byte ũ, Cache line (64 Byte)   ø ȴ.
+    ///  @param sequence[in] : true ̸  Message  Lane  Ѵ ü  ȣ δ.
+    ///                        Producer   ϴ counter ϳ  ŰǷ Push  þ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    ///              ̹ ִ Queue  lane_count, lane_size, sequence  ٸٸ BRING_QUEUE_INFO  return Ѵ.
+    int Initialize(const std::string& name, uint32_t lane_count, uint64_t lane_size, bool sequence = false);
+
+    ///  @brief      Lane  ȯ ϰ Shared Memory    ü  Ѵ.
+    void Finalize();
+
+    ///  @brief      Push   Lane   Ѵ. PushMessage()  ڵ ȣ ȴ.
+    ///               CPU ȣ % lane_count  Lane   ִ Lane  ã´.
+    ///  @return      ÿ 0,  Lane   ̸ NOT_ENOUGH_LANE  return Ѵ.
+    int AcquireLane();
+
+    ///  @brief       Lane  ȯ Ѵ. Lane   Message  Consumer     ִ.
+    void ReleaseLane();
+
+    ///  @brief       Lane  ȣ return Ѵ. ٸ -1  return Ѵ.
+    int GetLane() const;
+
+    ///  @brief      buffer  ϳ Message   Lane  ߰ Ѵ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    int PushMessage(const uint8_t* buffer, uint32_t buffer_len);
+
+    ///  @brief      ShardPolicy    Lane  Message ϳ buffer  copy ϰ  Ѵ.
+    ///  @param message_len[out] : Message  Byte ũ. buffer  ۴ٸ ʿ ũⰡ  ȴ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    int PopMessage(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len);
+
+    ///  @brief      PopMessage()   Message  ٸ timeout_ms   Ѵ.
+    ///  @return      ð  TIMEOUT_EXPIRED  return Ѵ.
+    int PopWait(uint8_t* buffer, uint32_t buffer_len, uint32_t* message_len, uint32_t timeout_ms);
+
+    ///  @brief      ִ max_count  Message  callback  ѱ   Ѵ.
+    ///              SHARD_POLICY_ROUND_ROBIN ̸ Lane ϳ    а  Lane  head  ѹ  Ѵ.
+    ///  @param popped_count[out] : callback  ѱ Message  
+    int PopBatch(uint32_t max_count, const CQueueSharedMemory::MessageCallback& callback, uint32_t* popped_count);
+
+    ///  @brief      Consumer  Lane     Ѵ. ⺻  sequence   Ǿٸ
+    ///              SHARD_POLICY_SEQUENCE, ƴ϶ SHARD_POLICY_ROUND_ROBIN ̴.
+    int SetPolicy(ShardPolicy policy);
+
+    ///  @brief       Lane   Byte ũ  return Ѵ. (Message header )
+    uint64_t GetUseSize() const;
+
+    ///  @brief      Lane   return Ѵ.
+    uint32_t GetLaneCount() const;
+
+    ///  @brief      Windows  GetLastError(), Linux  errno  return Ѵ.
+    uint32_t GetWinErrorCode() const;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedAttach.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedAttach
+///  @brief   ̸ Shared Memory  ų  ϰ  ⸦ ٸ.
+///           Shared Memory   տ std::atomic<uint32_t> magic  ־ ϸ
+///            ϴ  ٸ     magic  release    Ѵ.
+///            ϴ  magic  0  ƴϰ   acquire  Ȯ Ŀ   д´.
+///           CTypedSharedQueue, CShardedSharedQueue, CPrioritySharedQueue, CSharedSlabPool    Ѵ.
+
+#include "QueueSharedMemory.h"
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+class CSharedAttach
+{
+public:
+    static const uint32_t READY_TIMEOUT_MS = 1000;
+
+    ///  @brief        magic  0  ƴϰ    ִ READY_TIMEOUT_MS  ٸ.
+    ///  @return     magic   Ǿٸ true, ð  false  return Ѵ.
+    static bool WaitReady(const CSharedMemory& shared_memory)
+    {
+        if (shared_memory.GetSize() < sizeof(std::atomic<uint32_t>))
+            return false;
+
+        const std::atomic<uint32_t>* magic = reinterpret_cast<const std::atomic<uint32_t>*>(shared_memory.GetAddress());
+        if (0 != magic->load(std::memory_order_acquire))
+            return true;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(READY_TIMEOUT_MS);
+        while (0 == magic->load(std::memory_order_acquire))
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    ///  @brief      name  Shared Memory   ٸ create()   Ѵ.
+    ///              ٸ μ   ߴٸ ٽ    ߴٸ WaitReady()   ⸦ ٸ.
+    ///  @param create[in] : bool () · Shared Memory   ϰ magic   Ѵ.
+    ///  @param error_code[out] :  ߴٸ GetErrorCode()   ȴ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    template <typename CreateFunction>
+    static int OpenOrCreate(CSharedMemory& shared_memory, const std::string& name, CreateFunction create, uint32_t* error_code)
+    {
+        bool created = false;
+        if (false == shared_memory.Open(name))
+        {
+            created = create();
+            if (false == created && false == shared_memory.Open(name))
+            {
+                *error_code = shared_memory.GetErrorCode();
+                return CQueueSharedMemory::CREATE_MAMORY_MAP_HANDLE;
+            }
+        }
+
+        if (false == created && false == WaitReady(shared_memory))
+            return CQueueSharedMemory::BRING_QUEUE_INFO;
+
+        return 0;
+    }
+};
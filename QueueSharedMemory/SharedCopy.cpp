@@ -0,0 +1,223 @@
+#include "SharedCopy.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SHARED_COPY_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC  compile option    intrinsic     ִ.
+#define SHARED_COPY_TARGET(isa)
+#else
+#define SHARED_COPY_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+std::atomic<size_t> CSharedCopy::s_stream_threshold(CSharedCopy::DEFAULT_STREAM_THRESHOLD);
+
+typedef void (*StreamFunction)(uint8_t* destination, const uint8_t* source, size_t size);
+
+static const int KERNEL_NOT_DETECTED = -1;
+static std::atomic<int> s_kernel(KERNEL_NOT_DETECTED);
+
+static void StreamMemcpy(uint8_t* destination, const uint8_t* source, size_t size)
+{
+    memcpy(destination, source, size);
+}
+
+#ifdef SHARED_COPY_X86
+// non-temporal store  destination  width  ¾ƾ ϹǷ  κ   Ѵ.
+static void AlignDestination(uint8_t*& destination, const uint8_t*& source, size_t& size, size_t width)
+{
+    size_t head = (width - ((uintptr_t)destination & (width - 1))) & (width - 1);
+    if (head > size)
+        head = size;
+
+    memcpy(destination, source, head);
+    destination += head;
+    source += head;
+    size -= head;
+}
+
+SHARED_COPY_TARGET("sse2")
+static void StreamSse2(uint8_t* destination, const uint8_t* source, size_t size)
+{
+    AlignDestination(destination, source, size, 16);
+    for (; size >= 64; size -= 64, destination += 64, source += 64)
+    {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16));
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 32));
+        __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination), v0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + 16), v1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + 32), v2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + 48), v3);
+    }
+    for (; size >= 16; size -= 16, destination += 16, source += 16)
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination), _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+
+    memcpy(destination, source, size);
+
+    //  tail  (release store)   ̵ Ѵ.
+    _mm_sfence();
+}
+
+SHARED_COPY_TARGET("avx2")
+static void StreamAvx2(uint8_t* destination, const uint8_t* source, size_t size)
+{
+    AlignDestination(destination, source, size, 32);
+    for (; size >= 128; size -= 128, destination += 128, source += 128)
+    {
+        __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 32));
+        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 64));
+        __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination), v0);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + 32), v1);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + 64), v2);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + 96), v3);
+    }
+    for (; size >= 32; size -= 32, destination += 32, source += 32)
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+
+    memcpy(destination, source, size);
+
+    _mm_sfence();
+    _mm256_zeroupper();
+}
+
+SHARED_COPY_TARGET("avx512f")
+static void StreamAvx512(uint8_t* destination, const uint8_t* source, size_t size)
+{
+    AlignDestination(destination, source, size, 64);
+    for (; size >= 256; size -= 256, destination += 256, source += 256)
+    {
+        __m512i v0 = _mm512_loadu_si512(source);
+        __m512i v1 = _mm512_loadu_si512(source + 64);
+        __m512i v2 = _mm512_loadu_si512(source + 128);
+        __m512i v3 = _mm512_loadu_si512(source + 192);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination), v0);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination + 64), v1);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination + 128), v2);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination + 192), v3);
+    }
+    for (; size >= 64; size -= 64, destination += 64, source += 64)
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination), _mm512_loadu_si512(source));
+
+    memcpy(destination, source, size);
+
+    _mm_sfence();
+    _mm256_zeroupper();
+}
+
+#ifdef _MSC_VER
+// OS  ymm / zmm register   ϴ XCR0  Ȯ Ѵ.
+static bool IsSupported(CSharedCopy::CopyKernel kernel)
+{
+    if (CSharedCopy::COPY_KERNEL_MEMCPY == kernel)
+        return true;
+
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = 0 != (info[3] & (1 << 26));
+    bool osxsave = 0 != (info[2] & (1 << 27));
+    if (CSharedCopy::COPY_KERNEL_SSE2 == kernel)
+        return sse2;
+    if (false == osxsave || max_leaf < 7)
+        return false;
+
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (CSharedCopy::COPY_KERNEL_AVX2 == kernel)
+        return (0x06 == (xcr0 & 0x06)) && 0 != (info[1] & (1 << 5));
+    if (CSharedCopy::COPY_KERNEL_AVX512 == kernel)
+        return (0xE6 == (xcr0 & 0xE6)) && 0 != (info[1] & (1 << 16));
+
+    return false;
+}
+#else
+static bool IsSupported(CSharedCopy::CopyKernel kernel)
+{
+    __builtin_cpu_init();
+    if (CSharedCopy::COPY_KERNEL_SSE2 == kernel)
+        return 0 != __builtin_cpu_supports("sse2");
+    if (CSharedCopy::COPY_KERNEL_AVX2 == kernel)
+        return 0 != __builtin_cpu_supports("avx2");
+    if (CSharedCopy::COPY_KERNEL_AVX512 == kernel)
+        return 0 != __builtin_cpu_supports("avx512f");
+
+    return true;
+}
+#endif
+#else
+static bool IsSupported(CSharedCopy::CopyKernel kernel)
+{
+    return CSharedCopy::COPY_KERNEL_MEMCPY == kernel;
+}
+#endif
+
+CSharedCopy::CopyKernel CSharedCopy::DetectKernel()
+{
+    const CopyKernel kernels[] = { COPY_KERNEL_AVX512, COPY_KERNEL_AVX2, COPY_KERNEL_SSE2 };
+    for (CopyKernel kernel : kernels)
+    {
+        if (IsSupported(kernel))
+            return kernel;
+    }
+
+    return COPY_KERNEL_MEMCPY;
+}
+
+void CSharedCopy::CopyStream(void* destination, const void* source, size_t size)
+{
+    static const StreamFunction functions[] = {
+        StreamMemcpy,
+#ifdef SHARED_COPY_X86
+        StreamSse2,
+        StreamAvx2,
+        StreamAvx512,
+#endif
+    };
+
+    functions[GetKernel()](static_cast<uint8_t*>(destination), static_cast<const uint8_t*>(source), size);
+}
+
+void CSharedCopy::SetStreamThreshold(size_t size)
+{
+    s_stream_threshold.store(size, std::memory_order_relaxed);
+}
+
+size_t CSharedCopy::GetStreamThreshold()
+{
+    return s_stream_threshold.load(std::memory_order_relaxed);
+}
+
+CSharedCopy::CopyKernel CSharedCopy::GetKernel()
+{
+    //  thread  ó  Ȯ ص    Ѵ.
+    int kernel = s_kernel.load(std::memory_order_relaxed);
+    if (KERNEL_NOT_DETECTED == kernel)
+    {
+        kernel = DetectKernel();
+        s_kernel.store(kernel, std::memory_order_relaxed);
+    }
+
+    return (CopyKernel)kernel;
+}
+
+bool CSharedCopy::SetKernel(CopyKernel kernel)
+{
+    if (false == IsSupported(kernel))
+        return false;
+
+    s_kernel.store(kernel, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedCopy.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedCopy
+///  @brief   Queue   buffer   .
+///           SMALL_COPY_MAX ϴ  ũ  inline ó ϰ,   ũ memcpy   Ѵ.
+///           Shared Memory   簡 GetStreamThreshold() ̻ ̸ non-temporal store  Cache  ġ ʰ  Ͽ
+///           Consumer   ū Ͱ Producer  Cache  о  ʰ Ѵ.
+///           non-temporal store  kernel  ó    CPU  Ȯ Ͽ AVX-512 / AVX2 / SSE2   ϸ
+///           x86  ƴ϶ memcpy   Ѵ.   sfence  ϹǷ  release store     ִ.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class CSharedCopy
+{
+public:
+    enum CopyKernel
+    {
+        COPY_KERNEL_MEMCPY = 0,         // non-temporal store    ʴ´.
+        COPY_KERNEL_SSE2,               // 16 Byte _mm_stream_si128
+        COPY_KERNEL_AVX2,               // 32 Byte _mm256_stream_si256
+        COPY_KERNEL_AVX512,             // 64 Byte _mm512_stream_si512
+    };
+
+    static const size_t SMALL_COPY_MAX = 32;
+    static const size_t DEFAULT_STREAM_THRESHOLD = 1024 * 1024;
+
+private:
+    static std::atomic<size_t> s_stream_threshold;
+
+    // size  SMALL_COPY_MAX    / ڸ ļ  ũ  Ѵ.
+    static void CopySmall(uint8_t* destination, const uint8_t* source, size_t size)
+    {
+        if (size >= 16)
+        {
+            uint64_t head[2];
+            uint64_t tail[2];
+            memcpy(head, source, 16);
+            memcpy(tail, source + size - 16, 16);
+            memcpy(destination, head, 16);
+            memcpy(destination + size - 16, tail, 16);
+        }
+        else if (size >= 8)
+        {
+            uint64_t head;
+            uint64_t tail;
+            memcpy(&head, source, 8);
+            memcpy(&tail, source + size - 8, 8);
+            memcpy(destination, &head, 8);
+            memcpy(destination + size - 8, &tail, 8);
+        }
+        else if (size >= 4)
+        {
+            uint32_t head;
+            uint32_t tail;
+            memcpy(&head, source, 4);
+            memcpy(&tail, source + size - 4, 4);
+            memcpy(destination, &head, 4);
+            memcpy(destination + size - 4, &tail, 4);
+        }
+        else if (size)
+        {
+            uint8_t first = source[0];
+            uint8_t middle = source[size / 2];
+            uint8_t last = source[size - 1];
+            destination[0] = first;
+            destination[size / 2] = middle;
+            destination[size - 1] = last;
+        }
+    }
+
+    static void CopyStream(void* destination, const void* source, size_t size);
+
+public:
+    ///  @brief      Shared Memory   Ѵ. ũⰡ GetStreamThreshold() ̻ ̸ non-temporal store   Ѵ.
+    static void ToShared(void* destination, const void* source, size_t size)
+    {
+        if (size <= SMALL_COPY_MAX)
+            CopySmall(static_cast<uint8_t*>(destination), static_cast<const uint8_t*>(source), size);
+        else if (size < s_stream_threshold.load(std::memory_order_relaxed))
+            memcpy(destination, source, size);
+        else
+            CopyStream(destination, source, size);
+    }
+
+    ///  @brief      Shared Memory   buffer   Ѵ.   ٷ  ϹǷ Cache    Ѵ.
+    static void FromShared(void* destination, const void* source, size_t size)
+    {
+        if (size <= SMALL_COPY_MAX)
+            CopySmall(static_cast<uint8_t*>(destination), static_cast<const uint8_t*>(source), size);
+        else
+            memcpy(destination, source, size);
+    }
+
+    ///  @brief      non-temporal store    ּ Byte ũ⸦  Ѵ. μ ü  ȴ.
+    ///              SIZE_MAX ̸   ʴ´.
+    static void SetStreamThreshold(size_t size);
+
+    ///  @brief      non-temporal store    ּ Byte ũ⸦ return Ѵ.
+    static size_t GetStreamThreshold();
+
+    ///  @brief         kernel  return Ѵ.
+    static CopyKernel GetKernel();
+
+    ///  @brief      kernel   Ѵ.   뵵 ̴.
+    ///  @return     CPU    ʴ kernel ̸ false  return ϸ   ʴ´.
+    static bool SetKernel(CopyKernel kernel);
+
+    ///  @brief      CPU   ϴ   kernel  return Ѵ.
+    static CopyKernel DetectKernel();
+};
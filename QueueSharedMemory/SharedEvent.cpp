@@ -0,0 +1,114 @@
+#include "SharedEvent.h"
+
+#include <climits>
+
+#ifdef _WIN32
+#ifndef _WINDOWS_
+#include <windows.h>
+#endif
+#else
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+CSharedEvent::CSharedEvent()
+    : m_word(nullptr)
+#ifdef _WIN32
+    , m_event(NULL)
+#endif
+{
+
+}
+
+CSharedEvent::~CSharedEvent()
+{
+    Close();
+}
+
+bool CSharedEvent::Open(const std::string& name, std::atomic<uint32_t>* word)
+{
+    Close();
+
+#ifdef _WIN32
+    //  ڸ ѹ   ֵ Semaphore   Ѵ.
+    // ̹  ̸ Semaphore  ִٸ  Semaphore  .
+    m_event = CreateSemaphoreA(NULL, 0, LONG_MAX, name.c_str());
+    if (NULL == m_event)
+        return false;
+#else
+    (void)name;
+#endif
+
+    m_word = word;
+
+    return true;
+}
+
+void CSharedEvent::Close()
+{
+#ifdef _WIN32
+    if (m_event)
+    {
+        CloseHandle(m_event);
+        m_event = NULL;
+    }
+#endif
+
+    m_word = nullptr;
+}
+
+void CSharedEvent::Wait(uint32_t expected, uint32_t timeout_ms)
+{
+    if (nullptr == m_word)
+        return;
+
+#ifdef _WIN32
+    if (expected != m_word->load(std::memory_order_acquire))
+        return;
+
+    WaitForSingleObject(m_event, (WAIT_FOREVER == timeout_ms) ? INFINITE : timeout_ms);
+#else
+    //  μ ϴ  ̹Ƿ FUTEX_PRIVATE_FLAG   ʴ´.
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(m_word), FUTEX_WAIT, expected,
+        (WAIT_FOREVER == timeout_ms) ? nullptr : &timeout, nullptr, 0);
+#endif
+}
+
+void CSharedEvent::Wake(uint32_t count)
+{
+    if (nullptr == m_word || 0 == count)
+        return;
+
+    m_word->fetch_add(1, std::memory_order_release);
+
+#ifdef _WIN32
+    //     ŭ  count   Wait()  ѹ    ̴.
+    ReleaseSemaphore(m_event, (LONG)((count < LONG_MAX) ? count : LONG_MAX), NULL);
+#else
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(m_word), FUTEX_WAKE, (count < INT_MAX) ? (int)count : INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void CSharedEvent::CpuRelax()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
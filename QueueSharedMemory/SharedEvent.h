@@ -0,0 +1,56 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedEvent.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedEvent
+///  @brief   Shared Memory  32bit   μ  / ⸦ Ѵ.
+///           Linux   ü futex  ϰ, Windows  ̸ ִ Semaphore  Ѵ.
+///           (WaitOnAddress   μ ȿ  ϹǷ  ʴ´.)
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+class CSharedEvent
+{
+private:
+    std::atomic<uint32_t>*  m_word;
+#ifdef _WIN32
+    void*                   m_event;        // HANDLE (Semaphore)
+#endif
+
+public:
+    static const uint32_t WAIT_FOREVER = 0xFFFFFFFF;
+
+    CSharedEvent();
+    ~CSharedEvent();
+
+    CSharedEvent(const CSharedEvent&) = delete;
+    CSharedEvent& operator=(const CSharedEvent&) = delete;
+
+    ///  @brief      ⿡   ̸  Ѵ.
+    ///  @param name[in] : Windows Event  ̸,  ̸ ϴ μ    ִ.
+    ///  @param word[in] : Shared Memory ȿ ִ  ּ
+    ///  @return      ÿ true,  ÿ false  return Ѵ.
+    bool Open(const std::string& name, std::atomic<uint32_t>* word);
+
+    ///  @brief      Open()  Ҵ ü  Ѵ.
+    void Close();
+
+    ///  @brief       expected    Wake()  ȣ     Ѵ.
+    ///              ٸ    Ƿ ȣϴ ʿ  ٽ Ȯ ؾ Ѵ.
+    ///  @param expected[in] :   о 
+    ///  @param timeout_ms[in] : ִ  ð (ms), WAIT_FOREVER ̸  
+    void Wait(uint32_t expected, uint32_t timeout_ms);
+
+    ///  @brief        Ű   μ .
+    ///  @param count[in] :   
+    void Wake(uint32_t count = 1);
+
+    ///  @brief      Spin  ߿ CPU  纸 ϴ pause   Ѵ.
+    static void CpuRelax();
+};
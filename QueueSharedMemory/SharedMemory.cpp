@@ -0,0 +1,926 @@
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef _WINDOWS_
+#include <windows.h>
+#endif
+// VirtualAlloc2, MapViewOfFile3 (Windows 10 1803 ̻)
+#pragma comment(lib, "onecore.lib")
+#ifndef FILE_MAP_LARGE_PAGES
+#define FILE_MAP_LARGE_PAGES 0x20000000
+#endif
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#include <vector>
+#ifndef MADV_POPULATE_READ
+#define MADV_POPULATE_READ  22
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+// Shared Memory   տ ġ ϸ    ڿ ٴ´.
+struct alignas(64) CSharedMemory::SegmentInfo
+{
+    std::atomic<uint32_t>   attach_count;   //  mapping ϰ ִ ü 
+    std::atomic<uint32_t>   ready;          // Create()  ٸ     1   Ѵ.
+    uint64_t                size;           //   Byte ũ
+    uint64_t                mirror_offset;  // 0  ƴ϶   ι mapping Ǵ   ġ
+};
+
+// CREATE_FLAG_FILE  lock   ġ.  ũ   Ͱ   ġ  Ѵ.
+static const uint64_t FILE_LOCK_GATE  = 0x4000000000000000;     // Create() / Open()  ϳ  Ų.
+static const uint64_t FILE_LOCK_ALIVE = FILE_LOCK_GATE + 1;     //  Ǿ ִ   lock  ´.
+
+// Open()    ü SegmentInfo   Ǳ⸦ ٸ ִ ð
+static const uint32_t SEGMENT_READY_TIMEOUT_MS = 1000;
+
+static uint64_t AlignUp(uint64_t value, uint64_t align)
+{
+    return (value + align - 1) / align * align;
+}
+
+#ifdef _WIN32
+// Large page   Ϸ SeLockMemoryPrivilege  Ȱȭ Ǿ ־ Ѵ.
+static bool EnableLockMemoryPrivilege()
+{
+    HANDLE token = NULL;
+    if (FALSE == OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        return false;
+
+    TOKEN_PRIVILEGES privileges;
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    bool enabled = (FALSE != LookupPrivilegeValueA(NULL, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)) &&
+                   (FALSE != AdjustTokenPrivileges(token, FALSE, &privileges, 0, NULL, NULL)) &&
+                   (ERROR_SUCCESS == GetLastError());
+
+    CloseHandle(token);
+    return enabled;
+}
+#else
+static const char* HUGETLBFS_PATH = "/dev/hugepages";
+static const long HUGETLBFS_MAGIC_NUMBER = 0x958458f6;
+
+// libnuma (numaif.h)  mbind  ȣ ϱ  
+static const int NUMA_MPOL_BIND = 2;
+static const unsigned NUMA_MPOL_MF_MOVE = 1 << 1;
+
+static std::string ToPosixName(const std::string& name)
+{
+    // shm_open  ̸ '/'   ؾ Ѵ.
+    if (!name.empty() && '/' == name[0])
+        return name;
+
+    return "/" + name;
+}
+
+// hugetlbfs  mount Ǿ ִٸ    θ, ƴ϶  ڿ return Ѵ.
+static std::string ToHugePagesPath(const std::string& name, uint64_t* huge_page_size = nullptr)
+{
+    struct statfs fs;
+    if (-1 == statfs(HUGETLBFS_PATH, &fs) || HUGETLBFS_MAGIC_NUMBER != (long)fs.f_type)
+        return std::string();
+
+    if (huge_page_size)
+        *huge_page_size = (uint64_t)fs.f_bsize;
+
+    return HUGETLBFS_PATH + ToPosixName(name);
+}
+#endif
+
+CSharedMemory::CSharedMemory()
+#ifdef _WIN32
+    : m_memory_map(NULL)
+    , m_mirror_view(nullptr)
+    , m_file(NULL)
+#else
+    : m_fd(-1)
+#endif
+    , m_segment_info(nullptr)
+    , m_address(nullptr)
+    , m_size(0)
+    , m_mirror_offset(0)
+    , m_huge_pages(false)
+    , m_read_only(false)
+    , m_file_backed(false)
+    , m_exclusive(false)
+    , m_view_flags(0)
+    , m_numa_node(-1)
+    , m_error_code(0)
+{
+
+}
+
+CSharedMemory::~CSharedMemory()
+{
+    Close();
+}
+
+uint64_t CSharedMemory::GetAllocationGranularity()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+uint64_t CSharedMemory::GetHeaderSize()
+{
+    return sizeof(SegmentInfo);
+}
+
+bool CSharedMemory::Map(uint64_t size, uint64_t mirror_offset)
+{
+    uint64_t map_size = sizeof(SegmentInfo) + size;
+    uint8_t* address = nullptr;
+
+    if (0 == mirror_offset)
+    {
+#ifdef _WIN32
+        DWORD access = (m_read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS) | (m_huge_pages ? FILE_MAP_LARGE_PAGES : 0);
+        address = (uint8_t*)MapViewOfFile(m_memory_map, access, 0, 0, (SIZE_T)map_size);
+        if (nullptr == address)
+        {
+            m_error_code = GetLastError();
+            return false;
+        }
+#else
+        void* view = mmap(nullptr, (size_t)map_size, m_read_only ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (MAP_FAILED == view)
+        {
+            m_error_code = errno;
+            return false;
+        }
+
+        address = (uint8_t*)view;
+#endif
+    }
+    else
+    {
+        //   0              mirror_offset                 map_size
+        //   |--------------|*****************************|*****************************|
+        //   |<-------- ü ѹ mapping -------------->|<-- mirror  ٽ mapping ->|
+        uint64_t mirror_file_offset = sizeof(SegmentInfo) + mirror_offset;
+        uint64_t mirror_size = size - mirror_offset;
+
+#ifdef _WIN32
+        ULONG protect = m_read_only ? PAGE_READONLY : PAGE_READWRITE;
+
+        // ӵ ּ  placeholder  ϰ ѷ    view  mapping Ѵ.
+        address = (uint8_t*)VirtualAlloc2(nullptr, nullptr, (SIZE_T)(map_size + mirror_size),
+            MEM_RESERVE | MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS, nullptr, 0);
+        if (nullptr == address)
+        {
+            m_error_code = GetLastError();
+            return false;
+        }
+
+        if (FALSE == VirtualFree(address, (SIZE_T)map_size, MEM_RELEASE | MEM_PRESERVE_PLACEHOLDER))
+        {
+            m_error_code = GetLastError();
+            VirtualFree(address, 0, MEM_RELEASE);
+            return false;
+        }
+
+        void* view = MapViewOfFile3(m_memory_map, nullptr, address, 0, (SIZE_T)map_size,
+            MEM_REPLACE_PLACEHOLDER, protect, nullptr, 0);
+        if (nullptr == view)
+        {
+            m_error_code = GetLastError();
+            VirtualFree(address, 0, MEM_RELEASE);
+            VirtualFree(address + map_size, 0, MEM_RELEASE);
+            return false;
+        }
+
+        m_mirror_view = MapViewOfFile3(m_memory_map, nullptr, address + map_size, mirror_file_offset, (SIZE_T)mirror_size,
+            MEM_REPLACE_PLACEHOLDER, protect, nullptr, 0);
+        if (nullptr == m_mirror_view)
+        {
+            m_error_code = GetLastError();
+            UnmapViewOfFile(view);
+            VirtualFree(address + map_size, 0, MEM_RELEASE);
+            return false;
+        }
+#else
+        // ӵ ּ     fd  MAP_FIXED  ι mapping Ѵ.
+        void* reserve = mmap(nullptr, (size_t)(map_size + mirror_size), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == reserve)
+        {
+            m_error_code = errno;
+            return false;
+        }
+
+        int protect = m_read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        address = (uint8_t*)reserve;
+        if (MAP_FAILED == mmap(address, (size_t)map_size, protect, MAP_SHARED | MAP_FIXED, m_fd, 0) ||
+            MAP_FAILED == mmap(address + map_size, (size_t)mirror_size, protect, MAP_SHARED | MAP_FIXED, m_fd, (off_t)mirror_file_offset))
+        {
+            m_error_code = errno;
+            munmap(reserve, (size_t)(map_size + mirror_size));
+            return false;
+        }
+#endif
+    }
+
+    uint64_t mirror_size = mirror_offset ? size - mirror_offset : 0;
+    if (false == PrepareView(address, map_size, mirror_size))
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(address);
+        if (m_mirror_view)
+        {
+            UnmapViewOfFile(m_mirror_view);
+            m_mirror_view = nullptr;
+        }
+#else
+        munmap(address, (size_t)(map_size + mirror_size));
+#endif
+        return false;
+    }
+
+    m_segment_info = reinterpret_cast<SegmentInfo*>(address);
+    m_address = address + sizeof(SegmentInfo);
+    m_size = size;
+    m_mirror_offset = mirror_offset;
+
+    return true;
+}
+
+// mapping   ƹ page   ϱ  ȣ Ǿ ù Ҵ  NUMA node   ȴ.
+bool CSharedMemory::PrepareView(uint8_t* address, uint64_t map_size, uint64_t mirror_size)
+{
+#ifdef _WIN32
+    // NUMA node  CreateObject()   Ѵ. mirror   page ̹Ƿ  view  ó Ѵ.
+    if (m_view_flags & CREATE_FLAG_PREFAULT)
+    {
+        WIN32_MEMORY_RANGE_ENTRY range = { address, (SIZE_T)map_size };
+        if (FALSE == PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0))
+        {
+            m_error_code = GetLastError();
+            return false;
+        }
+    }
+
+    if (m_view_flags & CREATE_FLAG_LOCK)
+    {
+        // ּ working set   lock   Ƿ mapping ũ ŭ ø.
+        SIZE_T minimum_size = 0;
+        SIZE_T maximum_size = 0;
+        if (GetProcessWorkingSetSize(GetCurrentProcess(), &minimum_size, &maximum_size))
+            SetProcessWorkingSetSize(GetCurrentProcess(), minimum_size + (SIZE_T)map_size, maximum_size + (SIZE_T)map_size);
+
+        if (FALSE == VirtualLock(address, (SIZE_T)map_size))
+        {
+            m_error_code = GetLastError();
+            return false;
+        }
+    }
+    (void)mirror_size;
+#else
+    size_t length = (size_t)(map_size + mirror_size);
+
+    // shm ü policy  ü  ǹǷ mirror    mapping   ȴ.
+    if (0 <= m_numa_node)
+    {
+        const size_t mask_bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> node_mask(m_numa_node / mask_bits + 1, 0);
+        node_mask[m_numa_node / mask_bits] |= 1UL << (m_numa_node % mask_bits);
+        if (-1 == syscall(SYS_mbind, address, (unsigned long)map_size, NUMA_MPOL_BIND, node_mask.data(),
+            (unsigned long)(node_mask.size() * mask_bits + 1), NUMA_MPOL_MF_MOVE))
+        {
+            m_error_code = errno;
+            return false;
+        }
+    }
+
+    if (m_view_flags & CREATE_FLAG_PREFAULT)
+    {
+        if (-1 == madvise(address, length, m_read_only ? MADV_POPULATE_READ : MADV_POPULATE_WRITE))
+        {
+            if (EINVAL != errno)
+            {
+                m_error_code = errno;
+                return false;
+            }
+
+            // MADV_POPULATE    ʴ kernel (5.14 ̸)  page   Ѵ.
+            // ٸ μ    Ƿ  ٲ ʴ atomic   fault  .
+            uint64_t page_size = GetAllocationGranularity();
+            for (uint64_t offset = 0; offset < length; offset += page_size)
+            {
+                if (m_read_only)
+                    (void)*reinterpret_cast<volatile uint8_t*>(address + offset);
+                else
+                    __atomic_fetch_or(address + offset, (uint8_t)0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    if ((m_view_flags & CREATE_FLAG_LOCK) && -1 == mlock(address, length))
+    {
+        m_error_code = errno;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+bool CSharedMemory::ReadSegmentInfo(uint64_t* size, uint64_t* mirror_offset, bool* ready)
+{
+    // mapping  ˱  SegmentInfo   д´.
+#ifdef _WIN32
+    SegmentInfo* info = (SegmentInfo*)MapViewOfFile(m_memory_map, FILE_MAP_READ, 0, 0, sizeof(SegmentInfo));
+    if (nullptr == info && 0 != GetLargePageMinimum())
+    {
+        // Large page   ü Large page θ mapping   ִ.
+        info = (SegmentInfo*)MapViewOfFile(m_memory_map, FILE_MAP_READ | FILE_MAP_LARGE_PAGES, 0, 0, GetLargePageMinimum());
+        m_huge_pages = (nullptr != info);
+    }
+
+    if (nullptr == info)
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+
+    *ready = (0 != info->ready.load(std::memory_order_acquire));
+    *size = info->size;
+    *mirror_offset = info->mirror_offset;
+    UnmapViewOfFile(info);
+#else
+    struct stat st;
+    if (-1 == fstat(m_fd, &st))
+    {
+        m_error_code = errno;
+        return false;
+    }
+
+    // ϴ ʿ  ftruncate    
+    if ((uint64_t)st.st_size < sizeof(SegmentInfo))
+    {
+        *ready = false;
+        return true;
+    }
+
+    uint64_t header[sizeof(SegmentInfo) / sizeof(uint64_t)];
+    if ((ssize_t)sizeof(header) != pread(m_fd, header, sizeof(header), 0))
+    {
+        m_error_code = errno;
+        return false;
+    }
+
+    uint32_t ready_value = 0;
+    memcpy(&ready_value, reinterpret_cast<uint8_t*>(header) + offsetof(SegmentInfo, ready), sizeof(ready_value));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    *ready = (0 != ready_value);
+    *size = (uint64_t)st.st_size - sizeof(SegmentInfo);
+    *mirror_offset = header[offsetof(SegmentInfo, mirror_offset) / sizeof(uint64_t)];
+#endif
+
+    return true;
+}
+
+//   ü mirror_offset    аų attach_count    ʵ ready  ٸ.
+//  OpenFile()   lock    Ŀ Ƿ ٸ ʴ´.
+bool CSharedMemory::WaitSegmentInfo(uint64_t* size, uint64_t* mirror_offset)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SEGMENT_READY_TIMEOUT_MS);
+    while (true)
+    {
+        bool ready = false;
+        if (false == ReadSegmentInfo(size, mirror_offset, &ready))
+            return false;
+
+        if (ready || m_file_backed)
+            return true;
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+#ifdef _WIN32
+            m_error_code = ERROR_NOT_READY;
+#else
+            m_error_code = EAGAIN;
+#endif
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+bool CSharedMemory::CreateObject(uint64_t size, uint64_t mirror_offset)
+{
+    uint64_t map_size = sizeof(SegmentInfo) + size;
+
+#ifdef _WIN32
+    m_memory_map = CreateFileMappingNumaA(
+        INVALID_HANDLE_VALUE,               // hFile
+        NULL,                               // lpFileMappingAttributes
+        PAGE_READWRITE,                     // flProtect
+        (DWORD)(map_size >> 32),            // dwMaximumSizeHigh
+        (DWORD)(map_size & 0xFFFFFFFF),     // dwMaximumSizeLow
+        m_name.c_str(),                     // lpName
+        (0 <= m_numa_node) ? (DWORD)m_numa_node : NUMA_NO_PREFERRED_NODE);  // nndPreferred
+
+    if (NULL == m_memory_map)
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+
+    //  ̸ ü ̹ ִٸ  ü handle  return ȴ.
+    if (ERROR_ALREADY_EXISTS == GetLastError())
+    {
+        m_error_code = ERROR_ALREADY_EXISTS;
+        CloseHandle(m_memory_map);
+        m_memory_map = NULL;
+        return false;
+    }
+#else
+    std::string posix_name = ToPosixName(m_name);
+    m_fd = shm_open(posix_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (-1 == m_fd)
+    {
+        m_error_code = errno;
+        return false;
+    }
+
+    if (-1 == ftruncate(m_fd, (off_t)map_size))
+    {
+        m_error_code = errno;
+        close(m_fd);
+        m_fd = -1;
+        shm_unlink(posix_name.c_str());
+        return false;
+    }
+#endif
+
+    if (false == Map(size, mirror_offset))
+    {
+#ifndef _WIN32
+        shm_unlink(posix_name.c_str());
+#endif
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool CSharedMemory::CreateHugePages(uint64_t* size)
+{
+#ifdef _WIN32
+    EnableLockMemoryPrivilege();
+
+    uint64_t huge_page_size = GetLargePageMinimum();
+    if (0 == huge_page_size)
+    {
+        m_error_code = ERROR_NOT_SUPPORTED;
+        return false;
+    }
+
+    uint64_t map_size = AlignUp(sizeof(SegmentInfo) + *size, huge_page_size);
+    m_memory_map = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE | SEC_COMMIT | SEC_LARGE_PAGES,
+        (DWORD)(map_size >> 32), (DWORD)(map_size & 0xFFFFFFFF), m_name.c_str());
+    if (NULL == m_memory_map)
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+
+    if (ERROR_ALREADY_EXISTS == GetLastError())
+    {
+        m_error_code = ERROR_ALREADY_EXISTS;
+        CloseHandle(m_memory_map);
+        m_memory_map = NULL;
+        return false;
+    }
+
+    m_huge_pages = true;
+    if (Map(map_size - sizeof(SegmentInfo), 0))
+    {
+        *size = map_size - sizeof(SegmentInfo);
+        return true;
+    }
+
+    CloseHandle(m_memory_map);
+    m_memory_map = NULL;
+#else
+    uint64_t huge_page_size = 0;
+    std::string path = ToHugePagesPath(m_name, &huge_page_size);
+    if (path.empty() || 0 == huge_page_size)
+    {
+        m_error_code = ENOTSUP;
+        return false;
+    }
+
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (-1 == m_fd)
+    {
+        m_error_code = errno;
+        return false;
+    }
+
+    //  Huge page  ϸ mmap   Ѵ.
+    uint64_t map_size = AlignUp(sizeof(SegmentInfo) + *size, huge_page_size);
+    m_huge_pages = true;
+    if (-1 == ftruncate(m_fd, (off_t)map_size))
+        m_error_code = errno;
+    else if (Map(map_size - sizeof(SegmentInfo), 0))
+    {
+        *size = map_size - sizeof(SegmentInfo);
+        return true;
+    }
+
+    close(m_fd);
+    m_fd = -1;
+    unlink(path.c_str());
+#endif
+
+    m_huge_pages = false;
+    return false;
+}
+
+bool CSharedMemory::LockFileRange(uint64_t offset, bool exclusive, bool wait)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD flags = (exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0) | (wait ? 0 : LOCKFILE_FAIL_IMMEDIATELY);
+    if (FALSE == LockFileEx(m_file, flags, 0, 1, 0, &overlapped))
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+#else
+    //  μ  ٸ ü͵  ǵ open file description  lock   Ѵ.
+    struct flock lock = {};
+    lock.l_type = exclusive ? F_WRLCK : F_RDLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = (off_t)offset;
+    lock.l_len = 1;
+    if (-1 == fcntl(m_fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &lock))
+    {
+        m_error_code = errno;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+void CSharedMemory::UnlockFileRange(uint64_t offset)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    UnlockFileEx(m_file, 0, 1, 0, &overlapped);
+#else
+    struct flock lock = {};
+    lock.l_type = F_UNLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = (off_t)offset;
+    lock.l_len = 1;
+    fcntl(m_fd, F_OFD_SETLK, &lock);
+#endif
+}
+
+bool CSharedMemory::OpenFile(bool create, uint64_t map_size)
+{
+#ifdef _WIN32
+    m_file = CreateFileA(m_name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, create ? CREATE_NEW : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == m_file)
+    {
+        m_error_code = GetLastError();
+        m_file = NULL;
+        return false;
+    }
+#else
+    m_fd = open(m_name.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0666);
+    if (-1 == m_fd)
+    {
+        m_error_code = errno;
+        return false;
+    }
+#endif
+
+    m_file_backed = true;
+
+    // ٸ ü  ̶    ٸ.
+    //  Ǿ ִ ü ٸ ReleaseExclusive()   ü  ٸ Ѵ.
+    if (false == LockFileRange(FILE_LOCK_GATE, true, true))
+        return false;
+
+    m_exclusive = LockFileRange(FILE_LOCK_ALIVE, true, false);
+    if (m_exclusive)
+        UnlockFileRange(FILE_LOCK_ALIVE);
+
+    if (false == LockFileRange(FILE_LOCK_ALIVE, false, true))
+        return false;
+
+    if (false == m_exclusive)
+        UnlockFileRange(FILE_LOCK_GATE);
+
+#ifdef _WIN32
+    //  ÿ map_size   ũ⸦ ø,   (map_size 0)  ũ ü  Ѵ.
+    m_memory_map = CreateFileMappingA(m_file, NULL, PAGE_READWRITE, (DWORD)(map_size >> 32), (DWORD)(map_size & 0xFFFFFFFF), NULL);
+    if (NULL == m_memory_map)
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+#else
+    if (create && -1 == ftruncate(m_fd, (off_t)map_size))
+    {
+        m_error_code = errno;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+bool CSharedMemory::Create(const std::string& name, uint64_t size, uint64_t mirror_offset, uint32_t flags)
+{
+    Close();
+
+    m_name = name;
+    m_view_flags = flags & (CREATE_FLAG_PREFAULT | CREATE_FLAG_LOCK);
+
+    if (flags & CREATE_FLAG_FILE)
+    {
+        if (false == OpenFile(true, sizeof(SegmentInfo) + size) || false == Map(size, mirror_offset))
+        {
+            //  ü   ϸ .
+            bool remove_file = m_file_backed;
+            Close();
+            if (remove_file)
+                remove(name.c_str());
+
+            return false;
+        }
+
+        m_segment_info->size = size;
+        m_segment_info->mirror_offset = mirror_offset;
+        m_segment_info->attach_count.store(1);
+        m_segment_info->ready.store(1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Huge page     ٸ Ϲ page   Ѵ.  ̸ ̹    Ѵ.
+    bool huge_pages = false;
+    if ((flags & CREATE_FLAG_HUGE_PAGES) && 0 == mirror_offset)
+    {
+        huge_pages = CreateHugePages(&size);
+#ifdef _WIN32
+        if (ERROR_ALREADY_EXISTS == m_error_code)
+#else
+        if (EEXIST == m_error_code)
+#endif
+            return false;
+    }
+
+    if (false == huge_pages && false == CreateObject(size, mirror_offset))
+        return false;
+
+    m_segment_info->size = size;
+    m_segment_info->mirror_offset = mirror_offset;
+    m_segment_info->attach_count.store(1);
+    m_segment_info->ready.store(1, std::memory_order_release);
+
+    return true;
+}
+
+bool CSharedMemory::Open(const std::string& name, bool read_only, uint32_t flags)
+{
+    Close();
+
+    m_name = name;
+    m_read_only = read_only;
+    m_view_flags = flags & (CREATE_FLAG_PREFAULT | CREATE_FLAG_LOCK);
+
+    if (flags & CREATE_FLAG_FILE)
+    {
+        if (read_only)
+        {
+#ifdef _WIN32
+            m_error_code = ERROR_INVALID_PARAMETER;
+#else
+            m_error_code = EINVAL;
+#endif
+            return false;
+        }
+
+        if (false == OpenFile(false, 0))
+        {
+            Close();
+            return false;
+        }
+    }
+    else
+    {
+#ifdef _WIN32
+        m_memory_map = OpenFileMappingA(read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, FALSE, m_name.c_str());
+        if (!m_memory_map)
+        {
+            m_error_code = GetLastError();
+            return false;
+        }
+#else
+        int open_flags = read_only ? O_RDONLY : O_RDWR;
+        m_fd = shm_open(ToPosixName(m_name).c_str(), open_flags, 0666);
+        if (-1 == m_fd && ENOENT == errno)
+        {
+            // CREATE_FLAG_HUGE_PAGES   Ǿٸ hugetlbfs  ִ.
+            std::string path = ToHugePagesPath(m_name);
+            if (!path.empty() && -1 != (m_fd = open(path.c_str(), open_flags)))
+                m_huge_pages = true;
+            else
+                errno = ENOENT;
+        }
+
+        if (-1 == m_fd)
+        {
+            m_error_code = errno;
+            return false;
+        }
+#endif
+    }
+
+    uint64_t size = 0;
+    uint64_t mirror_offset = 0;
+    if (false == WaitSegmentInfo(&size, &mirror_offset) || false == Map(size, mirror_offset))
+    {
+        Close();
+        return false;
+    }
+
+    // б  attach_count     Ƿ ̸     ʴ´.
+    // ٸ    attach_count   μ   ̹Ƿ   Ѵ.
+    if (m_exclusive)
+        m_segment_info->attach_count.store(1);
+    else if (false == m_read_only)
+        m_segment_info->attach_count.fetch_add(1);
+
+    return true;
+}
+
+void CSharedMemory::Close()
+{
+    if (m_segment_info)
+    {
+        //   ü   д.
+        bool last = (false == m_read_only && 1 == m_segment_info->attach_count.fetch_sub(1) && false == m_file_backed);
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_segment_info);
+        if (m_mirror_view)
+        {
+            UnmapViewOfFile(m_mirror_view);
+            m_mirror_view = nullptr;
+        }
+        (void)last;
+#else
+        uint64_t mirror_size = m_mirror_offset ? m_size - m_mirror_offset : 0;
+        munmap(m_segment_info, (size_t)(sizeof(SegmentInfo) + m_size + mirror_size));
+
+        // Windows    ü   ̸  Ѵ.
+        if (last && m_huge_pages)
+            unlink(ToHugePagesPath(m_name).c_str());
+        else if (last)
+            shm_unlink(ToPosixName(m_name).c_str());
+#endif
+
+        m_segment_info = nullptr;
+        m_address = nullptr;
+        m_size = 0;
+        m_mirror_offset = 0;
+    }
+
+    m_huge_pages = false;
+    m_read_only = false;
+    m_file_backed = false;
+    m_exclusive = false;
+
+#ifdef _WIN32
+    if (m_memory_map)
+    {
+        CloseHandle(m_memory_map);
+        m_memory_map = NULL;
+    }
+
+    // lock  handle    ȴ.
+    if (m_file)
+    {
+        CloseHandle(m_file);
+        m_file = NULL;
+    }
+#else
+    if (-1 != m_fd)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+}
+
+void CSharedMemory::SetNumaNode(int numa_node)
+{
+    m_numa_node = numa_node;
+}
+
+uint8_t* CSharedMemory::GetAddress() const
+{
+    return m_address;
+}
+
+uint64_t CSharedMemory::GetSize() const
+{
+    return m_size;
+}
+
+bool CSharedMemory::IsHugePages() const
+{
+    return m_huge_pages;
+}
+
+bool CSharedMemory::IsReadOnly() const
+{
+    return m_read_only;
+}
+
+bool CSharedMemory::IsExclusive() const
+{
+    return m_exclusive;
+}
+
+void CSharedMemory::ReleaseExclusive()
+{
+    if (false == m_exclusive)
+        return;
+
+    UnlockFileRange(FILE_LOCK_GATE);
+    m_exclusive = false;
+}
+
+bool CSharedMemory::Flush(uint64_t offset, uint64_t size)
+{
+    if (false == m_file_backed || nullptr == m_segment_info || offset >= m_size)
+        return true;
+
+    if (size > m_size - offset)
+        size = m_size - offset;
+
+#ifdef _WIN32
+    // FlushViewOfFile   ۸ ϹǷ FlushFileBuffers  ϷḦ ٸ.
+    if (FALSE == FlushViewOfFile(m_address + offset, (SIZE_T)size) || FALSE == FlushFileBuffers(m_file))
+    {
+        m_error_code = GetLastError();
+        return false;
+    }
+#else
+    // msync  ּҴ page   Ѵ.
+    uint64_t page_size = GetAllocationGranularity();
+    uint64_t begin = (sizeof(SegmentInfo) + offset) / page_size * page_size;
+    uint64_t end = sizeof(SegmentInfo) + offset + size;
+    if (-1 == msync(reinterpret_cast<uint8_t*>(m_segment_info) + begin, (size_t)(end - begin), MS_SYNC))
+    {
+        m_error_code = errno;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+uint32_t CSharedMemory::GetErrorCode() const
+{
+    return m_error_code;
+}
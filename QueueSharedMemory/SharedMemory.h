@@ -0,0 +1,145 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedMemory.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedMemory
+///  @brief   ̸ Key  ϴ Shared Memory  / ϰ μ ּ  mapping Ѵ.
+///           Windows  CreateFileMapping / MapViewOfFile, Linux  shm_open / ftruncate / mmap  Ѵ.
+///           Linux  shm ü   ü Close()   shm_unlink ȴ.
+///           mirror_offset  ϸ     ޸𸮿 ι  mapping Ͽ
+///            buffer   Ѿ ٵ ϳ ӵ ּҷ   ִ.
+///           CREATE_FLAG_HUGE_PAGES  ϸ Linux  hugetlbfs (/dev/hugepages), Windows  SEC_LARGE_PAGES 
+///            õϰ    ٸ Ϲ page   Ѵ.
+///           CREATE_FLAG_FILE  ϸ name   η  Ͽ  mapping ϸ Close() Ŀ  ´.
+///           Ͽ     lock  ־ ٸ   ¿ ó  ߴ   ִ.
+///           CREATE_FLAG_PREFAULT / CREATE_FLAG_LOCK  SetNumaNode()  mapping  page   ϱ   ǹǷ
+///           ù  page fault   NUMA node  ޸𸮸  Ѵ.
+
+#include <cstdint>
+#include <string>
+
+class CSharedMemory
+{
+private:
+    struct SegmentInfo;
+
+    std::string    m_name;
+
+#ifdef _WIN32
+    void*          m_memory_map;        // HANDLE
+    void*          m_mirror_view;
+    void*          m_file;              // HANDLE, CREATE_FLAG_FILE
+#else
+    int            m_fd;
+#endif
+    SegmentInfo*   m_segment_info;
+    uint8_t*       m_address;
+    uint64_t       m_size;
+    uint64_t       m_mirror_offset;
+    bool           m_huge_pages;
+    bool           m_read_only;
+    bool           m_file_backed;
+    bool           m_exclusive;         // CREATE_FLAG_FILE : ٸ    lock   
+    uint32_t       m_view_flags;        // CREATE_FLAG_PREFAULT, CREATE_FLAG_LOCK
+    int            m_numa_node;         // 0 ̻ ̸ mapping  Ҵ  NUMA node
+
+    uint32_t       m_error_code;
+
+private:
+    bool Map(uint64_t size, uint64_t mirror_offset);
+    bool PrepareView(uint8_t* address, uint64_t map_size, uint64_t mirror_size);
+    bool ReadSegmentInfo(uint64_t* size, uint64_t* mirror_offset, bool* ready);
+    bool WaitSegmentInfo(uint64_t* size, uint64_t* mirror_offset);
+    bool CreateObject(uint64_t size, uint64_t mirror_offset);
+    bool CreateHugePages(uint64_t* size);
+    bool OpenFile(bool create, uint64_t map_size);
+    bool LockFileRange(uint64_t offset, bool exclusive, bool wait);
+    void UnlockFileRange(uint64_t offset);
+
+public:
+    enum CreateFlag
+    {
+        CREATE_FLAG_HUGE_PAGES = 0x01,  // Huge page (Large page)   õ Ѵ. mirror_offset  Բ    .
+        CREATE_FLAG_FILE       = 0x02,  // name   η  Ѵ. Open()   ؾ Ѵ.
+        CREATE_FLAG_PREFAULT   = 0x04,  // mapping   page  Ҵ ϰ page table  ä.  ٲ ʴ´.
+                                        // Linux  madvise (MADV_POPULATE_WRITE), Windows  PrefetchVirtualMemory   Ѵ.
+        CREATE_FLAG_LOCK       = 0x08,  // mapping   ޸𸮿  Ѵ. (Linux : mlock, Windows : VirtualLock)
+                                        //   ũ (RLIMIT_MEMLOCK / ּ working set)    Ѵ.
+    };
+
+    CSharedMemory();
+    ~CSharedMemory();
+
+    CSharedMemory(const CSharedMemory&) = delete;
+    CSharedMemory& operator=(const CSharedMemory&) = delete;
+
+    ///  @brief      size Byte ũ Shared Memory   ϰ mapping Ѵ.
+    ///               name  Shared Memory  ̹ ִٸ  Ѵ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @param size[in] : ڰ   Byte ũ
+    ///  @param mirror_offset[in] : 0  ƴ϶   [mirror_offset, size)  ι  mapping Ѵ.
+    ///                             GetHeaderSize() + mirror_offset  size - mirror_offset 
+    ///                             GetAllocationGranularity()   ̾ Ѵ.
+    ///  @param flags[in] : CreateFlag  . Huge page   Ǹ size  Huge page ũ  ø ȴ.
+    ///  @return      ÿ true,  ÿ false  return ϸ GetErrorCode()  code  Ȯ   ִ.
+    bool Create(const std::string& name, uint64_t size, uint64_t mirror_offset = 0, uint32_t flags = 0);
+
+    ///  @brief      ̹ Ǿ ִ Shared Memory   mapping Ѵ.
+    ///               ÿ mirror_offset   ߴٸ   mapping Ѵ.
+    ///              ٸ ü Create()  ̶        ٸ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @param read_only[in] : true ̸ б  mapping Ѵ.     ʾ
+    ///                          ü Close() ϸ ̸     ̹ mapping    ȴ.
+    ///  @param flags[in] : CREATE_FLAG_FILE ̸ name   . б  Բ    .
+    ///                     CREATE_FLAG_PREFAULT, CREATE_FLAG_LOCK   ü mapping   ȴ.
+    ///  @return      ÿ true,  ÿ false  return Ѵ.
+    bool Open(const std::string& name, bool read_only = false, uint32_t flags = 0);
+
+    ///  @brief       Create() / Open()  ޸𸮸 numa_node  Ҵ ϵ Ѵ. -1 ̸   ʴ´.
+    ///              Linux  mbind (MPOL_BIND)  ̹ Ҵ page  ű  ϸ Create() / Open()   Ѵ.
+    ///              Windows  Create()  CreateFileMappingNuma  ȣ node θ  Ѵ.
+    void SetNumaNode(int numa_node);
+
+    ///  @brief      mapping   Ѵ.
+    void Close();
+
+    ///  @brief         ּҸ return Ѵ.
+    ///  @return      ÿ ּ,  ÿ nullptr  return Ѵ.
+    uint8_t* GetAddress() const;
+
+    ///  @brief        Byte ũ⸦ return Ѵ. Huge page   Ǿٸ ø  ũ ̴.
+    uint64_t GetSize() const;
+
+    ///  @brief      Huge page  mapping Ǿ ִٸ true  return Ѵ.
+    bool IsHugePages() const;
+
+    ///  @brief      Open()  б  mapping ߴٸ true  return Ѵ.
+    bool IsReadOnly() const;
+
+    ///  @brief      CREATE_FLAG_FILE     ٸ  ٸ true  return Ѵ.
+    ///              ReleaseExclusive()  ȣ    ٸ ü Create() / Open()   ϹǷ
+    ///               μ  ¸  ̿    ִ.
+    bool IsExclusive() const;
+
+    ///  @brief      IsExclusive()     ٸ ü   Ų.
+    void ReleaseExclusive();
+
+    ///  @brief      CREATE_FLAG_FILE  mapping    [offset, offset + size)  Ͽ  ϰ Ϸ     Ѵ.
+    ///              Linux  msync (MS_SYNC), Windows  FlushViewOfFile / FlushFileBuffers   Ѵ.
+    ///  @return      ϰų  ƴ϶ true,  ÿ false  return Ѵ.
+    bool Flush(uint64_t offset, uint64_t size);
+
+    ///  @brief      Windows  GetLastError(), Linux  errno  return Ѵ.
+    uint32_t GetErrorCode() const;
+
+    ///  @brief      mapping ּҿ mirror   ϴ  return Ѵ.
+    ///              Windows  dwAllocationGranularity, Linux  page ũ ̴.
+    static uint64_t GetAllocationGranularity();
+
+    ///  @brief      Shared Memory տ ٴ   Byte ũ⸦ return Ѵ.
+    static uint64_t GetHeaderSize();
+};
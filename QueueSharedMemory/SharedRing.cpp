@@ -0,0 +1,13 @@
+#include "SharedRing.h"
+
+
+//////////////////////////////////////////////////////////////////////////
+
+void CSharedRing::Notify(Signal& signal, CSharedEvent& event)
+{
+    // tail  data_waiters б  ؾ Consumer  鼭 ġ ʴ´.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t waiters = signal.data_waiters.load(std::memory_order_relaxed);
+    if (waiters)
+        event.Wake(waiters);
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedRing.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedRing
+///  @brief   CShardedSharedQueue  Lane  CPrioritySharedQueue  Ring    ϴ SPSC Ring ó.
+///           head / tail  CQueueSharedMemory    ϸ  ġ ( % ring_size) ̴.
+///           Message  MessageHeader ڿ MESSAGE_ALIGN   Ring   ӵ  ϸ
+///           MESSAGE_WRAP_MARKER   0  .
+///           Signal  Shared Memory  δ   Producer  Notify(), Consumer  PopWait()   Ѵ.
+
+#include "QueueSharedMemory.h"
+#include "SharedEvent.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class CSharedRing
+{
+public:
+    static const uint32_t MESSAGE_ALIGN       = 8;
+    static const uint32_t MESSAGE_WRAP_MARKER = 0xFFFFFFFF;
+
+    // Ring  Message տ ٴ header
+    // length  MESSAGE_WRAP_MARKER  Ring   ǳʶٰ 0   Message  ִ.
+    struct MessageHeader
+    {
+        uint32_t    length;
+        uint32_t    sequence;   // ü  ȣ,   ʴ´ٸ 0
+    };
+    static_assert(sizeof(MessageHeader) == MESSAGE_ALIGN, "MessageHeader must be MESSAGE_ALIGN bytes");
+
+    // Consumer   Producer   
+    struct Signal
+    {
+        alignas(64) std::atomic<uint32_t>   data_event;
+        std::atomic<uint32_t>               data_waiters;
+    };
+
+    static uint64_t AlignUp(uint64_t value, uint64_t align)
+    {
+        return (value + (align - 1)) & ~(align - 1);
+    }
+
+    ///  @brief      length Byte  Message  Ring   ϴ Byte ũ⸦ return Ѵ.
+    static uint64_t RecordSize(uint32_t length)
+    {
+        return sizeof(MessageHeader) + AlignUp(length, MESSAGE_ALIGN);
+    }
+
+    ///  @brief      tail ġ length Byte  Message    header  return Ѵ. Producer  ȣ Ѵ.
+    ///              *cached_head     head  ٽ  ʿ ϴٸ wrap ǥø .
+    ///  @param next_tail[out] : Message    release    tail
+    ///  @return      ϴٸ nullptr  return Ѵ.
+    static MessageHeader* Reserve(uint8_t* data, uint64_t ring_size, uint64_t tail, const std::atomic<uint64_t>& head,
+                                  uint64_t* cached_head, uint32_t length, uint64_t* next_tail)
+    {
+        uint64_t record_size = RecordSize(length);
+        if (record_size > ring_size)
+            return nullptr;
+
+        uint64_t pos = tail % ring_size;
+        uint64_t skip_size = ring_size - pos < record_size ? ring_size - pos : 0;
+        uint64_t need_size = skip_size + record_size;
+
+        if (need_size > ring_size - (tail - *cached_head))
+        {
+            *cached_head = head.load(std::memory_order_acquire);
+            if (need_size > ring_size - (tail - *cached_head))
+                return nullptr;
+        }
+
+        if (skip_size)
+        {
+            reinterpret_cast<MessageHeader*>(&data[pos])->length = MESSAGE_WRAP_MARKER;
+            pos = 0;
+        }
+
+        *next_tail = tail + need_size;
+        return reinterpret_cast<MessageHeader*>(&data[pos]);
+    }
+
+    ///  @brief      *head ġ ִ Message  return Ѵ. Consumer  ȣ Ѵ.
+    ///              *cached_tail     tail  ٽ  wrap ǥð ִٸ *head  Ring  ó ű.
+    ///  @return     Message  ٸ nullptr  return Ѵ.
+    static MessageHeader* Front(uint8_t* data, uint64_t ring_size, const std::atomic<uint64_t>& tail,
+                                uint64_t* cached_tail, uint64_t* head)
+    {
+        uint64_t pos_head = *head;
+        if (*cached_tail == pos_head)
+        {
+            *cached_tail = tail.load(std::memory_order_acquire);
+            if (*cached_tail == pos_head)
+                return nullptr;
+        }
+
+        uint64_t pos = pos_head % ring_size;
+        MessageHeader* header = reinterpret_cast<MessageHeader*>(&data[pos]);
+        if (MESSAGE_WRAP_MARKER == header->length)
+        {
+            pos_head += ring_size - pos;
+            header = reinterpret_cast<MessageHeader*>(data);
+        }
+
+        *head = pos_head;
+        return header;
+    }
+
+    ///  @brief      tail   Ŀ ȣ Ͽ   Consumer  .
+    static void Notify(Signal& signal, CSharedEvent& event);
+
+    ///  @brief      pop()  POP_DATA_EMPTY   Notify()  timeout_ms  ٸ.
+    ///  @param pop[in] : int () · Message ϳ д´.
+    ///  @return     pop()  ,  ð  TIMEOUT_EXPIRED  return Ѵ.
+    template <typename PopFunction>
+    static int PopWait(Signal& signal, CSharedEvent& event, uint32_t timeout_ms, PopFunction pop)
+    {
+        int ret = pop();
+        if (CQueueSharedMemory::POP_DATA_EMPTY != ret)
+            return ret;
+
+        auto start = std::chrono::steady_clock::now();
+        while (true)
+        {
+            uint32_t wait_ms = CSharedEvent::WAIT_FOREVER;
+            if (CQueueSharedMemory::WAIT_FOREVER != timeout_ms)
+            {
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed >= timeout_ms)
+                    return CQueueSharedMemory::TIMEOUT_EXPIRED;
+
+                wait_ms = timeout_ms - (uint32_t)elapsed;
+            }
+
+            //   а waiters    ٽ Ȯ ؾ   Wake()  ġ ʴ´.
+            uint32_t expected = signal.data_event.load(std::memory_order_acquire);
+            signal.data_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+            ret = pop();
+            if (CQueueSharedMemory::POP_DATA_EMPTY == ret)
+                event.Wait(expected, wait_ms);
+
+            signal.data_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (CQueueSharedMemory::POP_DATA_EMPTY != ret)
+                return ret;
+
+            ret = pop();
+            if (CQueueSharedMemory::POP_DATA_EMPTY != ret)
+                return ret;
+        }
+    }
+};
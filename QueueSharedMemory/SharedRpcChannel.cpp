@@ -0,0 +1,186 @@
+#include "SharedRpcChannel.h"
+
+#include <string.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+
+// û /  Message  տ ٴ header.  ڿ  Ͱ ִ.
+struct CSharedRpcChannel::RpcHeader
+{
+    uint64_t    correlation_id;
+    uint32_t    code;           // û method,  status
+    uint32_t    reserved;
+};
+
+CSharedRpcChannel::CSharedRpcChannel()
+    : m_role(RPC_ROLE_CLIENT)
+    , m_next_id(1)
+{
+
+}
+
+CSharedRpcChannel::~CSharedRpcChannel()
+{
+    Finalize();
+}
+
+int CSharedRpcChannel::Initialize(const std::string& name, uint64_t queue_size, RpcRole role)
+{
+    Finalize();
+
+    int ret = m_request_queue.Initialize(name + "_Request", queue_size);
+    if (0 == ret)
+        ret = m_response_queue.Initialize(name + "_Response", queue_size);
+    if (ret)
+    {
+        Finalize();
+        return ret;
+    }
+
+    m_role = role;
+
+    return 0;
+}
+
+void CSharedRpcChannel::Finalize()
+{
+    m_request_queue.Finalize();
+    m_response_queue.Finalize();
+    m_pending.clear();
+}
+
+// header   ͸ ϳ Message  ߰ Ѵ.
+int CSharedRpcChannel::Send(CQueueSharedMemory& queue, uint64_t correlation_id, uint32_t code, const uint8_t* buffer, uint32_t buffer_len)
+{
+    RpcHeader header = { correlation_id, code, 0 };
+    CQueueSharedMemory::MessageBuffer fragments[2] = {
+        { reinterpret_cast<const uint8_t*>(&header), sizeof(header) },
+        { buffer, buffer_len },
+    };
+
+    return queue.PushMessage(fragments, 2);
+}
+
+void CSharedRpcChannel::DispatchReply(const uint8_t* message, uint32_t message_len)
+{
+    if (message_len < sizeof(RpcHeader))
+        return;
+
+    RpcHeader header;
+    memcpy(&header, message, sizeof(header));
+
+    // Cancel()  û  .
+    auto it = m_pending.find(header.correlation_id);
+    if (m_pending.end() == it)
+        return;
+
+    // callback ȿ Call()  ȣ   Ƿ  .
+    ReplyCallback callback = std::move(it->second);
+    m_pending.erase(it);
+
+    callback(header.code, message + sizeof(header), message_len - (uint32_t)sizeof(header));
+}
+
+void CSharedRpcChannel::DispatchRequest(const uint8_t* message, uint32_t message_len, const RequestCallback& handler)
+{
+    if (message_len < sizeof(RpcHeader))
+        return;
+
+    RpcHeader header;
+    memcpy(&header, message, sizeof(header));
+
+    handler(header.correlation_id, header.code, message + sizeof(header), message_len - (uint32_t)sizeof(header));
+}
+
+int CSharedRpcChannel::Call(uint32_t method, const uint8_t* buffer, uint32_t buffer_len, ReplyCallback callback, uint64_t* correlation_id)
+{
+    if (RPC_ROLE_CLIENT != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+    if (UINT32_MAX - sizeof(RpcHeader) < buffer_len)
+        return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE;
+
+    //    ϰ  ϸ .
+    uint64_t id = m_next_id;
+    auto result = m_pending.emplace(id, std::move(callback));
+
+    int ret = Send(m_request_queue, id, method, buffer, buffer_len);
+    if (ret)
+    {
+        m_pending.erase(result.first);
+        return ret;
+    }
+
+    m_next_id++;
+    if (correlation_id)
+        *correlation_id = id;
+
+    return 0;
+}
+
+int CSharedRpcChannel::Cancel(uint64_t correlation_id)
+{
+    if (0 == m_pending.erase(correlation_id))
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    return 0;
+}
+
+int CSharedRpcChannel::PollReplies(uint32_t max_count, uint32_t* completed)
+{
+    *completed = 0;
+    if (RPC_ROLE_CLIENT != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+
+    return m_response_queue.PopBatch(max_count, [this](const uint8_t* message, uint32_t message_len) {
+        DispatchReply(message, message_len);
+    }, completed);
+}
+
+int CSharedRpcChannel::WaitReplies(uint32_t timeout_ms, uint32_t* completed)
+{
+    *completed = 0;
+    if (RPC_ROLE_CLIENT != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+
+    return m_response_queue.PopBatchWait(UINT32_MAX, [this](const uint8_t* message, uint32_t message_len) {
+        DispatchReply(message, message_len);
+    }, completed, timeout_ms);
+}
+
+size_t CSharedRpcChannel::GetPendingCount() const
+{
+    return m_pending.size();
+}
+
+int CSharedRpcChannel::PollRequests(uint32_t max_count, const RequestCallback& handler, uint32_t* handled)
+{
+    *handled = 0;
+    if (RPC_ROLE_SERVER != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+
+    return m_request_queue.PopBatch(max_count, [&](const uint8_t* message, uint32_t message_len) {
+        DispatchRequest(message, message_len, handler);
+    }, handled);
+}
+
+int CSharedRpcChannel::WaitRequests(uint32_t timeout_ms, const RequestCallback& handler, uint32_t* handled)
+{
+    *handled = 0;
+    if (RPC_ROLE_SERVER != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+
+    return m_request_queue.PopBatchWait(UINT32_MAX, [&](const uint8_t* message, uint32_t message_len) {
+        DispatchRequest(message, message_len, handler);
+    }, handled, timeout_ms);
+}
+
+int CSharedRpcChannel::Reply(uint64_t correlation_id, uint32_t status, const uint8_t* buffer, uint32_t buffer_len)
+{
+    if (RPC_ROLE_SERVER != m_role)
+        return CQueueSharedMemory::NOT_SUPPORTED_MODE;
+    if (UINT32_MAX - sizeof(RpcHeader) < buffer_len)
+        return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE;
+
+    return Send(m_response_queue, correlation_id, status, buffer, buffer_len);
+}
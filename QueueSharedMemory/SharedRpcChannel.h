@@ -0,0 +1,108 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedRpcChannel.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedRpcChannel
+///  @brief   û Queue   Queue ΰ (name_Request, name_Response)  Client  Server  û /  ְ ޴´.
+///            Message տ 64bit û ȣ (correlation id)  ̹Ƿ Client   ٸ ʰ
+///            û    (pipelining), Server         ִ.
+///           Client  û ȣ   callback    PollReplies()    ѹ ó Ѵ.
+///            Queue  SPSC ̹Ƿ Client ü ϳ, Server ü ϳ     ְ   thread   ؾ Ѵ.
+
+#include "QueueSharedMemory.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+class CSharedRpcChannel
+{
+public:
+    enum RpcRole
+    {
+        RPC_ROLE_CLIENT = 0,            // û   ޴´.
+        RPC_ROLE_SERVER,                // û ް  .
+    };
+
+    // Server   û  ȣ ȴ. buffer  Shared Memory  ּҷ callback ȿ ȿ ϴ.
+    //  callback ȿ Ǵ ߿ correlation_id  Reply() Ѵ.
+    typedef std::function<void(uint64_t correlation_id, uint32_t method, const uint8_t* buffer, uint32_t buffer_len)> RequestCallback;
+
+    // Client     ѹ ȣ ȴ. buffer  callback ȿ ȿ ϴ.
+    typedef std::function<void(uint32_t status, const uint8_t* buffer, uint32_t buffer_len)> ReplyCallback;
+
+private:
+    struct RpcHeader;
+
+    CQueueSharedMemory  m_request_queue;
+    CQueueSharedMemory  m_response_queue;
+    RpcRole        m_role;
+
+    // Client  
+    uint64_t       m_next_id;
+    std::unordered_map<uint64_t, ReplyCallback> m_pending;
+
+private:
+    int Send(CQueueSharedMemory& queue, uint64_t correlation_id, uint32_t code, const uint8_t* buffer, uint32_t buffer_len);
+    void DispatchReply(const uint8_t* message, uint32_t message_len);
+    void DispatchRequest(const uint8_t* message, uint32_t message_len, const RequestCallback& handler);
+
+public:
+    CSharedRpcChannel();
+    ~CSharedRpcChannel();
+
+    CSharedRpcChannel(const CSharedRpcChannel&) = delete;
+    CSharedRpcChannel& operator=(const CSharedRpcChannel&) = delete;
+
+    ///  @brief      û /  Queue   ϰų ̹ ִ Queue   Ѵ.
+    ///  @param name[in] : Queue ̸  κ
+    ///  @param queue_size[in] : û /  Queue  Byte ũ.    ũ⸦ .
+    ///  @param role[in] :  ü Client  Server 
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    int Initialize(const std::string& name, uint64_t queue_size, RpcRole role);
+
+    ///  @brief      Queue  ݰ ٸ ִ û .  û callback  ȣ  ʴ´.
+    void Finalize();
+
+    ///  @brief      Client : û    callback   Ѵ.  ٸ ʴ´.
+    ///  @param method[in] : Server  RequestCallback   Ǵ 
+    ///  @param callback[in] :   ϸ PollReplies() / WaitReplies() ȿ ȣ ȴ.
+    ///  @param correlation_id[out] : nullptr  ƴ϶ û ȣ  ȴ. Cancel()   Ѵ.
+    ///  @return      ÿ 0, û Queue   áٸ NOT_ENOUGH_FREE_SPACE  return ϸ callback    ʴ´.
+    int Call(uint32_t method, const uint8_t* buffer, uint32_t buffer_len, ReplyCallback callback, uint64_t* correlation_id = nullptr);
+
+    ///  @brief      Client :  ٸ û callback  . ߿   .
+    ///  @return      ÿ 0, ٸ û ƴ϶ RANGE_IS_NOT_RIGHT  return Ѵ.
+    int Cancel(uint64_t correlation_id);
+
+    ///  @brief      Client :   ִ max_count   copy  callback  ѱ.
+    ///  @param completed[out] : ó  
+    ///  @return      ÿ 0,  ٸ POP_DATA_EMPTY  return Ѵ.
+    int PollReplies(uint32_t max_count, uint32_t* completed);
+
+    ///  @brief      Client :  ٸ timeout_ms  ٸ     copy  ó Ѵ.
+    ///  @return      ð  TIMEOUT_EXPIRED  return Ѵ.
+    int WaitReplies(uint32_t timeout_ms, uint32_t* completed);
+
+    ///  @brief      Client :  ٸ û  return Ѵ.
+    size_t GetPendingCount() const;
+
+    ///  @brief      Server :  û ִ max_count   copy  handler  ѱ.
+    ///  @param handled[out] : ó û 
+    ///  @return      ÿ 0, û ٸ POP_DATA_EMPTY  return Ѵ.
+    int PollRequests(uint32_t max_count, const RequestCallback& handler, uint32_t* handled);
+
+    ///  @brief      Server : û ٸ timeout_ms  ٸ   û  copy  ó Ѵ.
+    ///  @return      ð  TIMEOUT_EXPIRED  return Ѵ.
+    int WaitRequests(uint32_t timeout_ms, const RequestCallback& handler, uint32_t* handled);
+
+    ///  @brief      Server : correlation_id  û  Ѵ.
+    ///  @param status[in] : Client  ReplyCallback   Ǵ 
+    ///  @return      ÿ 0,  Queue   áٸ NOT_ENOUGH_FREE_SPACE  return Ѵ.
+    int Reply(uint64_t correlation_id, uint32_t status, const uint8_t* buffer, uint32_t buffer_len);
+};
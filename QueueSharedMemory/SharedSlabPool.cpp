@@ -0,0 +1,314 @@
+#include "SharedSlabPool.h"
+
+#include <atomic>
+
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    const uint32_t POOL_INFO_MAGIC   = 0x51534D42;  // 'QSMB'
+    const uint32_t POOL_INFO_VERSION = 1;
+
+    const uint32_t BLOCK_ALIGN       = 64;          // block  Cache line  .
+
+    const uint32_t BLOCK_FREE        = 0;
+    const uint32_t BLOCK_ALLOCATED   = 1;
+
+    uint64_t AlignUp(uint64_t value, uint64_t align)
+    {
+        return (value + (align - 1)) & ~(align - 1);
+    }
+}
+
+// Shared Memory   տ ġ ϸ  ڿ SlabClass[class_count], class  BlockInfo 迭 block  ٴ´.
+struct CSharedSlabPool::PoolInfo
+{
+    //  ÿ ѹ  Ǵ 
+    alignas(64) std::atomic<uint32_t>   magic;
+    uint32_t                version;
+    uint32_t                class_count;
+};
+
+// size class ϳ  free list
+struct CSharedSlabPool::SlabClass
+{
+    //  ÿ ѹ  Ǵ 
+    alignas(64) uint64_t    block_size;
+    uint64_t                info_offset;    // PoolInfo   BlockInfo[block_count]  Byte ũ
+    uint64_t                data_offset;    // PoolInfo   ù block  Byte ũ
+    uint32_t                block_count;
+
+    // free list   .  32bit  block ȣ + 1 (0 ̸  ),  32bit  ABA       ϴ tag ̴.
+    alignas(64) std::atomic<uint64_t>   free_head;
+    std::atomic<uint32_t>               free_count;
+};
+
+// block  block   δ . block     .
+struct CSharedSlabPool::BlockInfo
+{
+    std::atomic<uint32_t>   next;           // free list   block ȣ + 1
+    std::atomic<uint32_t>   state;          // BLOCK_FREE / BLOCK_ALLOCATED
+};
+
+CSharedSlabPool::CSharedSlabPool()
+    : m_pool_info(nullptr)
+    , m_classes(nullptr)
+    , m_base(nullptr)
+    , m_class_count(0)
+    , m_error_code(0)
+{
+
+}
+
+CSharedSlabPool::~CSharedSlabPool()
+{
+    Finalize();
+}
+
+bool CSharedSlabPool::CreateSharedMemory(const std::vector<SizeClass>& size_classes)
+{
+    uint64_t size = AlignUp(sizeof(PoolInfo) + sizeof(SlabClass) * size_classes.size(), BLOCK_ALIGN);
+    std::vector<uint64_t> info_offsets;
+    std::vector<uint64_t> data_offsets;
+    for (const SizeClass& size_class : size_classes)
+    {
+        info_offsets.push_back(size);
+        size = AlignUp(size + sizeof(BlockInfo) * (uint64_t)size_class.block_count, BLOCK_ALIGN);
+        data_offsets.push_back(size);
+        size += size_class.block_size * size_class.block_count;
+    }
+
+    if (false == m_shared_memory.Create(m_name, size))
+    {
+        m_error_code = m_shared_memory.GetErrorCode();
+        return false;
+    }
+
+    PoolInfo* pool_info = reinterpret_cast<PoolInfo*>(m_shared_memory.GetAddress());
+    SlabClass* classes = reinterpret_cast<SlabClass*>(pool_info + 1);
+    for (size_t i = 0; i < size_classes.size(); i++)
+    {
+        SlabClass& slab_class = classes[i];
+        slab_class.block_size = size_classes[i].block_size;
+        slab_class.block_count = size_classes[i].block_count;
+        slab_class.info_offset = info_offsets[i];
+        slab_class.data_offset = data_offsets[i];
+
+        //  block  ȣ  free list   Ѵ.
+        BlockInfo* blocks = reinterpret_cast<BlockInfo*>(reinterpret_cast<uint8_t*>(pool_info) + info_offsets[i]);
+        for (uint32_t n = 0; n < slab_class.block_count; n++)
+            blocks[n].next.store(n + 1 < slab_class.block_count ? n + 2 : 0, std::memory_order_relaxed);
+
+        slab_class.free_head.store(slab_class.block_count ? 1 : 0, std::memory_order_relaxed);
+        slab_class.free_count.store(slab_class.block_count, std::memory_order_relaxed);
+    }
+
+    pool_info->class_count = (uint32_t)size_classes.size();
+    pool_info->version = POOL_INFO_VERSION;
+    pool_info->magic.store(POOL_INFO_MAGIC, std::memory_order_release);
+
+    return true;
+}
+
+bool CSharedSlabPool::GetSharedPoint()
+{
+    if (m_shared_memory.GetSize() < sizeof(PoolInfo))
+        return false;
+
+    PoolInfo* pool_info = reinterpret_cast<PoolInfo*>(m_shared_memory.GetAddress());
+    if (POOL_INFO_MAGIC != pool_info->magic.load(std::memory_order_acquire) || POOL_INFO_VERSION != pool_info->version ||
+        m_shared_memory.GetSize() < sizeof(PoolInfo) + sizeof(SlabClass) * (uint64_t)pool_info->class_count)
+        return false;
+
+    SlabClass* classes = reinterpret_cast<SlabClass*>(pool_info + 1);
+    for (uint32_t i = 0; i < pool_info->class_count; i++)
+    {
+        if (m_shared_memory.GetSize() < classes[i].data_offset + classes[i].block_size * classes[i].block_count)
+            return false;
+    }
+
+    m_pool_info = pool_info;
+    m_classes = classes;
+    m_base = reinterpret_cast<uint8_t*>(pool_info);
+    m_class_count = pool_info->class_count;
+
+    return true;
+}
+
+int CSharedSlabPool::Initialize(const std::string& name, const std::vector<SizeClass>& size_classes)
+{
+    Finalize();
+
+    if (size_classes.empty())
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    std::vector<SizeClass> aligned_classes;
+    for (const SizeClass& size_class : size_classes)
+    {
+        SizeClass aligned = { AlignUp(size_class.block_size, BLOCK_ALIGN), size_class.block_count };
+        if (0 == aligned.block_size || 0 == aligned.block_count ||
+            (!aligned_classes.empty() && aligned.block_size <= aligned_classes.back().block_size))
+            return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+        aligned_classes.push_back(aligned);
+    }
+
+    m_name = name;
+
+    int ret = CSharedAttach::OpenOrCreate(m_shared_memory, m_name,
+        [&]() { return CreateSharedMemory(aligned_classes); }, &m_error_code);
+    if (ret)
+    {
+        Finalize();
+        return ret;
+    }
+
+    bool matched = GetSharedPoint() && aligned_classes.size() == m_class_count;
+    for (uint32_t i = 0; matched && i < m_class_count; i++)
+        matched = aligned_classes[i].block_size == m_classes[i].block_size && aligned_classes[i].block_count == m_classes[i].block_count;
+
+    if (false == matched)
+    {
+        Finalize();
+        return CQueueSharedMemory::BRING_QUEUE_INFO;
+    }
+
+    return 0;
+}
+
+void CSharedSlabPool::Finalize()
+{
+    m_shared_memory.Close();
+    m_pool_info = nullptr;
+    m_classes = nullptr;
+    m_base = nullptr;
+    m_class_count = 0;
+}
+
+CSharedSlabPool::BlockInfo* CSharedSlabPool::GetBlockInfo(const SlabClass& slab_class, uint32_t index) const
+{
+    return reinterpret_cast<BlockInfo*>(m_base + slab_class.info_offset) + index;
+}
+
+// offset  Ű block  class  ȣ ã´. block   ƴ϶ false  return Ѵ.
+bool CSharedSlabPool::FindBlock(uint64_t offset, uint32_t* class_index, uint32_t* block_index) const
+{
+    for (uint32_t i = 0; i < m_class_count; i++)
+    {
+        const SlabClass& slab_class = m_classes[i];
+        if (offset < slab_class.data_offset || offset >= slab_class.data_offset + slab_class.block_size * slab_class.block_count)
+            continue;
+
+        uint64_t relative = offset - slab_class.data_offset;
+        if (0 != relative % slab_class.block_size)
+            return false;
+
+        *class_index = i;
+        *block_index = (uint32_t)(relative / slab_class.block_size);
+        return true;
+    }
+
+    return false;
+}
+
+int CSharedSlabPool::Allocate(uint64_t size, SlabHandle* handle, uint8_t** data)
+{
+    if (nullptr == m_pool_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    for (uint32_t i = 0; i < m_class_count; i++)
+    {
+        SlabClass& slab_class = m_classes[i];
+        if (slab_class.block_size < size)
+            continue;
+
+        // free list    CAS  . tag  ٲǷ  ̿  ٽ  block  ȥ  ʴ´.
+        uint64_t head = slab_class.free_head.load(std::memory_order_acquire);
+        while (0 != (uint32_t)head)
+        {
+            uint32_t index = (uint32_t)head - 1;
+            uint32_t next = GetBlockInfo(slab_class, index)->next.load(std::memory_order_relaxed);
+            uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+            if (false == slab_class.free_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+                continue;
+
+            GetBlockInfo(slab_class, index)->state.store(BLOCK_ALLOCATED, std::memory_order_relaxed);
+            slab_class.free_count.fetch_sub(1, std::memory_order_relaxed);
+
+            handle->offset = slab_class.data_offset + slab_class.block_size * index;
+            handle->length = size;
+            if (data)
+                *data = m_base + handle->offset;
+
+            return 0;
+        }
+    }
+
+    return CQueueSharedMemory::NOT_ENOUGH_FREE_SPACE;
+}
+
+int CSharedSlabPool::Free(const SlabHandle& handle)
+{
+    if (nullptr == m_pool_info)
+        return CQueueSharedMemory::DID_NOT_INITIALIZE;
+
+    uint32_t class_index = 0;
+    uint32_t block_index = 0;
+    if (false == FindBlock(handle.offset, &class_index, &block_index))
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    // ι ȯ Ǿ free list   ʵ ¸  ٲ۴.
+    SlabClass& slab_class = m_classes[class_index];
+    BlockInfo* block = GetBlockInfo(slab_class, block_index);
+    uint32_t expected = BLOCK_ALLOCATED;
+    if (false == block->state.compare_exchange_strong(expected, BLOCK_FREE, std::memory_order_relaxed))
+        return CQueueSharedMemory::RANGE_IS_NOT_RIGHT;
+
+    // block     Ҵ ޴    ̵ release  ִ´.
+    uint64_t head = slab_class.free_head.load(std::memory_order_relaxed);
+    uint64_t new_head = 0;
+    do
+    {
+        block->next.store((uint32_t)head, std::memory_order_relaxed);
+        new_head = (((head >> 32) + 1) << 32) | (block_index + 1);
+    } while (false == slab_class.free_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+
+    slab_class.free_count.fetch_add(1, std::memory_order_relaxed);
+
+    return 0;
+}
+
+uint8_t* CSharedSlabPool::GetAddress(const SlabHandle& handle) const
+{
+    if (nullptr == m_pool_info)
+        return nullptr;
+
+    uint32_t class_index = 0;
+    uint32_t block_index = 0;
+    if (false == FindBlock(handle.offset, &class_index, &block_index) || handle.length > m_classes[class_index].block_size)
+        return nullptr;
+
+    return m_base + handle.offset;
+}
+
+uint64_t CSharedSlabPool::GetBlockSize(uint32_t class_index) const
+{
+    if (class_index >= m_class_count)
+        return 0;
+
+    return m_classes[class_index].block_size;
+}
+
+uint32_t CSharedSlabPool::GetFreeCount(uint32_t class_index) const
+{
+    if (class_index >= m_class_count)
+        return 0;
+
+    return m_classes[class_index].free_count.load(std::memory_order_relaxed);
+}
+
+uint32_t CSharedSlabPool::GetWinErrorCode() const
+{
+    return m_error_code;
+}
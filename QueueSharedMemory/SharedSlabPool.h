@@ -0,0 +1,101 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    SharedSlabPool.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CSharedSlabPool
+///  @brief   ū ͸ Queue  copy  ʰ ѱ  Shared Memory   ũ block pool.
+///            ÿ  ũ  (size class)  block   class  lock-free free list (Treiber stack)  д.
+///           Producer  Allocate()   block   ͸  SlabHandle  Queue  ѱ
+///           Consumer  GetAddress()  block    Free()  ȯ Ѵ.
+///           block  Ҵ ä  μ block  ȸ  ʴ´.
+
+#include "QueueSharedMemory.h"
+#include "SharedAttach.h"
+#include "SharedMemory.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CSharedSlabPool
+{
+public:
+    //  ÿ  ϴ ũ  block  
+    struct SizeClass
+    {
+        uint64_t    block_size;     // Cache line (64 Byte)   ø ȴ.
+        uint32_t    block_count;
+    };
+
+    // Queue  ѱ block  ġ. offset  pool  Ƿ ٸ μ     ִ.
+    struct SlabHandle
+    {
+        uint64_t    offset;
+        uint64_t    length;         // ڰ   Byte ũ
+    };
+
+private:
+    struct PoolInfo;
+    struct SlabClass;
+    struct BlockInfo;
+
+    std::string    m_name;
+
+    CSharedMemory  m_shared_memory;
+    PoolInfo*      m_pool_info;
+    SlabClass*     m_classes;
+    uint8_t*       m_base;
+    uint32_t       m_class_count;
+
+    uint32_t       m_error_code;
+
+private:
+    bool CreateSharedMemory(const std::vector<SizeClass>& size_classes);
+    bool GetSharedPoint();
+    BlockInfo* GetBlockInfo(const SlabClass& slab_class, uint32_t index) const;
+    bool FindBlock(uint64_t offset, uint32_t* class_index, uint32_t* block_index) const;
+
+public:
+    CSharedSlabPool();
+    ~CSharedSlabPool();
+
+    CSharedSlabPool(const CSharedSlabPool&) = delete;
+    CSharedSlabPool& operator=(const CSharedSlabPool&) = delete;
+
+    ///  @brief      ̸ pool   ϰų ̹ ִ pool   Ѵ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @param size_classes[in] : block_size   ϴ  size class .       ؾ Ѵ.
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    ///              ̹ ִ pool   ٸٸ BRING_QUEUE_INFO  return Ѵ.
+    int Initialize(const std::string& name, const std::vector<SizeClass>& size_classes);
+
+    ///  @brief      Shared Memory    ü  Ѵ.
+    void Finalize();
+
+    ///  @brief      size Byte ̻ block ϳ Ҵ Ѵ. ´ class   ִٸ  ū class  Ҵ Ѵ.
+    ///  @param handle[out] : Ҵ block  offset, length  size   ȴ.
+    ///  @param data[out] : nullptr  ƴ϶ block  ּҰ  ȴ.
+    ///  @return      ÿ 0, Ҵ   ִ block  ٸ NOT_ENOUGH_FREE_SPACE  return Ѵ.
+    int Allocate(uint64_t size, SlabHandle* handle, uint8_t** data = nullptr);
+
+    ///  @brief      Allocate()  Ҵ block  pool  ȯ Ѵ.  μ  ȯ   ִ.
+    ///  @return      ÿ 0, block  ġ ƴϰų ̹ ȯ block ̶ RANGE_IS_NOT_RIGHT  return Ѵ.
+    int Free(const SlabHandle& handle);
+
+    ///  @brief      handle  Ű block  ּҸ return Ѵ.
+    ///  @return      ÿ ּ, handle  block    ٸ nullptr  return Ѵ.
+    uint8_t* GetAddress(const SlabHandle& handle) const;
+
+    ///  @brief      class_index ° size class  block ũ⸦ return Ѵ.
+    uint64_t GetBlockSize(uint32_t class_index) const;
+
+    ///  @brief      class_index ° size class  Ҵ   block   return Ѵ.
+    uint32_t GetFreeCount(uint32_t class_index) const;
+
+    ///  @brief      Windows  GetLastError(), Linux  errno  return Ѵ.
+    uint32_t GetWinErrorCode() const;
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+///  @file    TypedSharedQueue.h
+///  @date    2026/10/17
+///
+
+//////////////////////////////////////////////////////////////////////////
+///  @class   CTypedSharedQueue
+///  @brief   T ϳ Slot  ϴ  ũ SPSC Queue  Shared Memory   Ѵ.
+///           Slot  T[Capacity] 迭 ġ Ǹ Capacity  2  ŵ ̹Ƿ ġ & (Capacity - 1)  Ѵ.
+///            Լ header  ־ Push() / Pop()  ȣϴ ʿ inline ȴ.
+///              Shared Memory  ϵ T  ũ Capacity  ٸٸ  Ѵ.
+
+#include "QueueSharedMemory.h"
+#include "SharedAttach.h"
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+template <typename T, uint32_t Capacity>
+class CTypedSharedQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(Capacity >= 2 && 0 == (Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+private:
+    static const uint32_t QUEUE_INFO_MAGIC   = 0x51534D54;  // 'QSMT'
+    static const uint32_t QUEUE_INFO_VERSION = 1;
+    static const uint32_t SLOT_MASK          = Capacity - 1;
+
+    // Shared Memory 󿡼  Ǵ Queue  . CQueueSharedMemory   head / tail   Ѵ.
+    struct QueueInfo
+    {
+        //  ÿ ѹ  Ǵ 
+        alignas(64) std::atomic<uint32_t>   magic;
+        uint32_t                version;
+        uint32_t                element_size;   // sizeof(T)
+        uint32_t                capacity;       // Capacity
+        uint32_t                slot_offset;    // QueueInfo   T[Capacity]  Byte ũ
+
+        // Producer   Cache line
+        alignas(64) std::atomic<uint64_t>   tail;
+
+        // Consumer   Cache line
+        alignas(64) std::atomic<uint64_t>   head;
+    };
+
+    // T   Cache line  ũٸ   .
+    static const uint64_t SLOT_OFFSET = (sizeof(QueueInfo) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    std::string    m_name;
+
+    CSharedMemory  m_shared_memory;
+    QueueInfo*     m_queue_info;
+    T*             m_slots;
+
+    //  index  local 纻
+    uint64_t       m_cached_head;       // Producer  
+    uint64_t       m_cached_tail;       // Consumer  
+
+    uint32_t       m_error_code;
+
+private:
+    bool CreateSharedMemory()
+    {
+        if (false == m_shared_memory.Create(m_name, SLOT_OFFSET + sizeof(T) * (uint64_t)Capacity))
+        {
+            m_error_code = m_shared_memory.GetErrorCode();
+            return false;
+        }
+
+        QueueInfo* queue_info = reinterpret_cast<QueueInfo*>(m_shared_memory.GetAddress());
+        queue_info->element_size = sizeof(T);
+        queue_info->capacity = Capacity;
+        queue_info->slot_offset = (uint32_t)SLOT_OFFSET;
+        queue_info->version = QUEUE_INFO_VERSION;
+        queue_info->magic.store(QUEUE_INFO_MAGIC, std::memory_order_release);
+
+        return true;
+    }
+
+    bool GetSharedPoint()
+    {
+        if (m_shared_memory.GetSize() < sizeof(QueueInfo))
+            return false;
+
+        QueueInfo* queue_info = reinterpret_cast<QueueInfo*>(m_shared_memory.GetAddress());
+        if (QUEUE_INFO_MAGIC != queue_info->magic.load(std::memory_order_acquire) || QUEUE_INFO_VERSION != queue_info->version)
+            return false;
+
+        // ٸ T  Capacity   Queue    ʴ´.
+        if (sizeof(T) != queue_info->element_size || Capacity != queue_info->capacity || SLOT_OFFSET != queue_info->slot_offset)
+            return false;
+
+        if (m_shared_memory.GetSize() < SLOT_OFFSET + sizeof(T) * (uint64_t)Capacity)
+            return false;
+
+        m_queue_info = queue_info;
+        m_slots = reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(queue_info) + SLOT_OFFSET);
+
+        return true;
+    }
+
+public:
+    CTypedSharedQueue()
+        : m_queue_info(nullptr)
+        , m_slots(nullptr)
+        , m_cached_head(0)
+        , m_cached_tail(0)
+        , m_error_code(0)
+    {
+
+    }
+
+    ~CTypedSharedQueue()
+    {
+        Finalize();
+    }
+
+    CTypedSharedQueue(const CTypedSharedQueue&) = delete;
+    CTypedSharedQueue& operator=(const CTypedSharedQueue&) = delete;
+
+    ///  @brief      ̸ Queue   ϰų ̹ ִ Queue   Ѵ.
+    ///  @param name[in] : Shared Memory  ̸
+    ///  @return      ÿ 0,  ÿ CQueueSharedMemory::FailedCode  return Ѵ.
+    ///              T  ũ⳪ Capacity  ٸ Queue  BRING_QUEUE_INFO  return Ѵ.
+    int Initialize(const std::string& name)
+    {
+        Finalize();
+        m_name = name;
+
+        int ret = CSharedAttach::OpenOrCreate(m_shared_memory, m_name, [this]() { return CreateSharedMemory(); }, &m_error_code);
+        if (ret)
+        {
+            Finalize();
+            return ret;
+        }
+
+        if (false == GetSharedPoint())
+        {
+            Finalize();
+            return CQueueSharedMemory::BRING_QUEUE_INFO;
+        }
+
+        m_cached_head = m_queue_info->head.load(std::memory_order_acquire);
+        m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+
+        return 0;
+    }
+
+    ///  @brief      Shared Memory    ü  Ѵ.
+    void Finalize()
+    {
+        m_shared_memory.Close();
+        m_queue_info = nullptr;
+        m_slots = nullptr;
+    }
+
+    ///  @brief      value  Queue  ڿ ߰ Ѵ. Initialize()   Ŀ ȣ ؾ Ѵ.
+    ///  @return      ÿ true, Queue   áٸ false  return Ѵ.
+    bool Push(const T& value)
+    {
+        // tail  Producer   ϹǷ relaxed  д´.
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head >= Capacity)
+        {
+            m_cached_head = m_queue_info->head.load(std::memory_order_acquire);
+            if (tail - m_cached_head >= Capacity)
+                return false;
+        }
+
+        m_slots[tail & SLOT_MASK] = value;
+        m_queue_info->tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    ///  @brief      Queue     value  copy ϰ  Ѵ. Initialize()   Ŀ ȣ ؾ Ѵ.
+    ///  @return      ÿ true, Queue   ִٸ false  return Ѵ.
+    bool Pop(T& value)
+    {
+        // head  Consumer   ϹǷ relaxed  д´.
+        uint64_t head = m_queue_info->head.load(std::memory_order_relaxed);
+        if (m_cached_tail == head)
+        {
+            m_cached_tail = m_queue_info->tail.load(std::memory_order_acquire);
+            if (m_cached_tail == head)
+                return false;
+        }
+
+        value = m_slots[head & SLOT_MASK];
+        m_queue_info->head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    ///  @brief      Queue   ִ T   return Ѵ.
+    uint32_t GetUseCount() const
+    {
+        if (!m_queue_info)
+            return 0;
+
+        // head   о tail  Ŀ ʴ´.
+        uint64_t head = m_queue_info->head.load(std::memory_order_acquire);
+        uint64_t tail = m_queue_info->tail.load(std::memory_order_acquire);
+
+        return (uint32_t)(tail - head);
+    }
+
+    ///  @brief      Queue     ִ T  ִ  return Ѵ.
+    static constexpr uint32_t GetCapacity()
+    {
+        return Capacity;
+    }
+
+    ///  @brief      Windows  GetLastError(), Linux  errno  return Ѵ.
+    uint32_t GetWinErrorCode() const
+    {
+        return m_error_code;
+    }
+};
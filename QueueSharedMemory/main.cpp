@@ -1,10 +1,65 @@
 ﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <iostream>
 #include <chrono>
 #include <thread>
 
 #include "QueueSharedMemory.h"
 
+// Queue 에 읽기 전용으로 연결 하여 사용량과 통계를 출력 한다. interval_ms 가 0 이 아니라면 그 간격으로 계속 출력 한다.
+static int PrintStatistics(const std::string& name, uint32_t interval_ms)
+{
+    CQueueSharedMemory queue;
+    int ret = queue.InitializeReadOnly(name);
+    if (ret)
+    {
+        printf("queue attach failed   code[%d]\n", ret);
+        return 1;
+    }
+
+    CQueueSharedMemory::Statistics previous = {};
+    bool has_previous = false;
+    while (true)
+    {
+        printf("use[%llu / %llu]", (unsigned long long)queue.GetUseSize(), (unsigned long long)queue.GetQueueSize());
+
+        CQueueSharedMemory::Statistics statistics = {};
+        ret = queue.GetStatistics(&statistics);
+        if (0 == ret)
+        {
+            printf("  high_water[%llu]  push[%llu msgs  %llu bytes]  full[%llu]  push_wait[%llu]  pop[%llu msgs  %llu bytes]  pop_wait[%llu]",
+                (unsigned long long)statistics.high_water_size,
+                (unsigned long long)statistics.push_count, (unsigned long long)statistics.push_bytes,
+                (unsigned long long)statistics.push_full_count, (unsigned long long)statistics.push_wait_count,
+                (unsigned long long)statistics.pop_count, (unsigned long long)statistics.pop_bytes,
+                (unsigned long long)statistics.pop_wait_count);
+
+            if (has_previous)
+            {
+                double seconds = interval_ms / 1000.0;
+                printf("  push/s[%.0f]  pop/s[%.0f]",
+                    (statistics.push_count - previous.push_count) / seconds, (statistics.pop_count - previous.pop_count) / seconds);
+            }
+
+            previous = statistics;
+            has_previous = true;
+        }
+        else if (CQueueSharedMemory::STATISTICS_DISABLED == ret)
+            printf("  (statistics disabled)");
+
+        printf("\n");
+        fflush(stdout);
+
+        if (0 == interval_ms)
+            break;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+
+    return 0;
+}
+
 int main(int argc, char* argv[])
 {
     if (argc < 2)
@@ -13,9 +68,23 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    // test excute : QueueSharedMemory.exe test
     std::string name = argv[1];
+    if ("test" == name)
+        return TestQueueSharedMemory();
+
+    if (argc < 3)
+    {
+        printf("no input mode...");
+        return 0;
+    }
+
     std::string mode = argv[2];
 
+    // stats excute : QueueSharedMemory.exe MySharedMemory stats [interval_ms]
+    if ("stats" == mode)
+        return PrintStatistics(name, (argc > 3) ? (uint32_t)atoi(argv[3]) : 0);
+
     CQueueSharedMemory queue;
     int ret = queue.Initialize(name, 1024);
     if (ret)
@@ -24,7 +93,7 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    printf("Start name[%s]  Mode[%s]  QueueSize[%d]\n", name.c_str(), mode.c_str(), queue.GetQueueSize());
+    printf("Start name[%s]  Mode[%s]  QueueSize[%llu]\n", name.c_str(), mode.c_str(), (unsigned long long)queue.GetQueueSize());
 
     std::string message;
 
@@ -32,20 +101,13 @@ int main(int argc, char* argv[])
     {
         if ("server" == mode)
         {
-            uint32_t use_size = queue.GetUseSize();
-            if (0 == use_size)
-            {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            uint32_t message_len = 0;
+            message.resize((size_t)queue.GetQueueSize());
+            if (queue.PopWait((uint8_t*)&message[0], (uint32_t)message.size(), &message_len, CQueueSharedMemory::WAIT_FOREVER))
                 continue;
-            }
-
-            static uint8_t buffer[64] = { 0, };
-            memset(buffer, 0, sizeof(buffer));
 
-            queue.Front(buffer, use_size);
-            queue.Pop();
+            message.resize(message_len);
 
-            message = (char*)buffer;
             printf("recv  message [%s] len[%d]\n", message.c_str(), message.size());
         }
         else if ("client" == mode)
@@ -53,7 +115,7 @@ int main(int argc, char* argv[])
             printf("input message : ");
             std::getline(std::cin, message);
 
-            queue.Push((uint8_t*)message.c_str(), (uint32_t)message.size());
+            queue.PushMessage((const uint8_t*)message.c_str(), (uint32_t)message.size());
             printf("send  message [%s] len[%d]\n", message.c_str(), message.size());
         }
 